@@ -0,0 +1,100 @@
+// Copy a large range of elements in parallel
+// C++11
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+const std::size_t parallel_copy_threshold = 64 * 1024 * 1024;
+
+template <typename T>
+void large_copy(const T* first, const T* last, T* dest)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+  std::size_t size = last - first;
+  unsigned threads = std::thread::hardware_concurrency();
+
+  if (size * sizeof(T) < parallel_copy_threshold || threads < 2)
+  {
+    std::copy(first, last, dest);
+    return;
+  }
+
+  std::size_t chunk = size / threads;
+  std::vector<std::future<void>> copies;
+
+  for (unsigned i = 0; i < threads - 1; ++i)
+  {
+    copies.push_back(std::async(std::launch::async, [=] {
+      std::copy(first + i * chunk, first + (i + 1) * chunk,
+                dest + i * chunk);
+    }));
+  }
+
+  std::copy(first + (threads - 1) * chunk, last,
+            dest + (threads - 1) * chunk);
+
+  for (std::future<void>& copy : copies)
+  {
+    copy.get();
+  }
+}
+
+int main()
+{
+  std::vector<int> source(32 * 1024 * 1024);
+  std::vector<int> target(source.size());
+
+  large_copy(source.data(), source.data() + source.size(),
+             target.data());
+}
+
+// Split a very large copy across multiple threads, while leaving
+// small copies unchanged.
+//
+// A single thread usually cannot use all of the memory bandwidth
+// available on a modern processor. When a buffer is much larger than
+// the processor's caches, [copying it](/patterns/copy-range-of-elements.html)
+// with several threads at once can therefore finish sooner.
+//
+// The `large_copy` function template on [13-46] copies the elements
+// between the pointers `first` and `last` to `dest`. We use
+// `static_assert` on [16-17] to accept only [trivially
+// copyable](cpp/types/is_trivially_copyable) element types, which
+// can safely be copied in any order and from any thread.
+//
+// Starting a thread costs far more than copying a small buffer, so
+// we only parallelize copies of at least `parallel_copy_threshold`
+// bytes, defined on [11]. Smaller copies, or copies on a system with
+// only one hardware thread, are performed with
+// [`std::copy`](cpp/algorithm/copy) on [22-26]. A good threshold
+// depends on the system and should be chosen by [measuring the
+// execution time](/patterns/measure-execution-time.html) of both
+// approaches.
+//
+// For large copies, we divide the range into equal chunks, one for
+// each hardware thread reported by
+// [`std::thread::hardware_concurrency`](cpp/thread/thread/hardware_concurrency)
+// on [20]. On [31-37], we start an asynchronous task with
+// [`std::async`](cpp/thread/async) for each chunk except the last.
+// The lambda captures `first`, `dest`, `chunk` and the index `i` by
+// value, so each task copies its own chunk. On [39-40], we copy the
+// last chunk, which also includes any elements left over by the
+// division, on the current thread. Finally, on [42-45], we call `get`
+// on each [`std::future`](cpp/thread/future) to wait for all chunks
+// to be copied. If starting a task throws an exception, the futures
+// that have already been created wait for their tasks to finish when
+// they are destroyed, so no task is left copying into `dest`.
+//
+// **Note**: A copy of a buffer larger than the last-level cache
+// evicts everything else from the cache, slowing down any work that
+// follows it. Processors provide *non-temporal* store instructions
+// that write to memory without keeping the data in the cache. Standard
+// C++ cannot express them, but many `std::memcpy` implementations use
+// them automatically above a size threshold. They can also be
+// accessed through compiler-specific intrinsics.
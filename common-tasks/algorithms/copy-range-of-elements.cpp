@@ -46,6 +46,12 @@ void foo(RangeOfInts source)
 // `std::copy` ([20-21]), we call [`std::back_inserter`](cpp/iterator/back_inserter)
 // to get an iterator that automatically calls `push_back` on `target3`
 // for each element that is copied.
+//
+// **Note**: Since `std::back_inserter` adds one element at a time,
+// `target3` may reallocate several times during the copy. To
+// [append a range to a container](/patterns/append-range-to-container.html),
+// it is usually better to call the container's `insert` member
+// function with the whole range.
 
 int main()
 {
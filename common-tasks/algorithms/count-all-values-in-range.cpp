@@ -0,0 +1,109 @@
+// Count occurrences of all values in a range
+// C++11
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+const std::size_t cache_line_size = 64;
+
+std::vector<std::size_t> count_all(const std::vector<int>& values,
+                                   int max_value, unsigned tasks)
+{
+  tasks = std::max(1u, tasks);
+
+  std::size_t chunk = (values.size() + tasks - 1) / tasks;
+  std::size_t padding = cache_line_size / sizeof(std::size_t);
+  std::vector<std::future<std::vector<std::size_t>>> partials;
+
+  for (unsigned i = 0; i < tasks; ++i)
+  {
+    std::size_t first = std::min(i * chunk, values.size());
+    std::size_t last = std::min(first + chunk, values.size());
+
+    partials.push_back(std::async(std::launch::async,
+      [&values, max_value, padding, first, last] {
+        std::vector<std::size_t> counts(max_value + 1 + padding);
+        for (std::size_t j = first; j < last; ++j)
+          ++counts[values[j]];
+        return counts;
+      }));
+  }
+
+  std::vector<std::size_t> counts(max_value + 1);
+
+  for (std::future<std::vector<std::size_t>>& partial : partials)
+  {
+    std::vector<std::size_t> partial_counts = partial.get();
+    for (int value = 0; value <= max_value; ++value)
+      counts[value] += partial_counts[value];
+  }
+
+  return counts;
+}
+
+int main()
+{
+  std::vector<int> numbers = {1, 2, 3, 5, 6, 3, 4, 1};
+  unsigned tasks = std::max(1u, std::thread::hardware_concurrency());
+
+  std::vector<std::size_t> counts = count_all(numbers, 6, tasks);
+
+  std::size_t threes = counts[3];
+}
+
+// Count the occurrences of every value in a range in a single pass,
+// using multiple threads.
+//
+// To [count the occurrences of a value](/patterns/count-values-in-range.html),
+// [`std::count`](cpp/algorithm/count) reads the entire range. If we
+// need the counts of many different values, calling `std::count` for
+// each of them reads the range many times. When the values lie in a
+// small, known domain, we can instead count all of them at once.
+//
+// The `count_all` function on [12-45] counts how many times each value
+// from 0 to `max_value` occurs in `values`, dividing the work between
+// `tasks` tasks. It returns a `std::vector` in which the element at
+// index `v` is the number of occurrences of the value `v`.
+//
+// If `tasks` is zero, as `std::thread::hardware_concurrency` may
+// return, we use a single task instead on [15].
+//
+// On [21-33], we divide `values` into `tasks` chunks of roughly equal
+// size and start a task for each chunk with
+// [`std::async`](cpp/thread/async). Each task creates its own
+// `counts` vector on [28] and, on [29-30], increments the element for
+// each value in its chunk. Because each task only ever writes to its
+// own vector, the tasks do not need to synchronize.
+//
+// The vectors are allocated separately, but two small heap
+// allocations may still lie within the same cache line. Each
+// increment would then force the other task's processor core to
+// reload that cache line, an effect known as [false
+// sharing](https://en.wikipedia.org/wiki/False_sharing). To prevent
+// this, we add `padding` unused elements to the end of each vector,
+// which occupy `cache_line_size` bytes ([10] and [18]). The elements
+// that two different tasks write to are then always at least a whole
+// cache line apart. The padding elements are never read.
+//
+// On [37-42], we wait for each task to finish by calling `get` on its
+// [`std::future`](cpp/thread/future), which gives us its partial
+// counts. We then add them to the total counts. Merging costs time
+// proportional to the size of the domain for each task, which is
+// small compared to counting a large range.
+//
+// In `main`, we count the values in `numbers`, which are all between
+// 0 and 6, on [52]. On [54], we then read the number of threes
+// without reading `numbers` again.
+//
+// **Note**: 64 bytes is the size of a cache line on most current
+// processors. C++17 provides
+// [`std::hardware_destructive_interference_size`](cpp/thread/hardware_destructive_interference_size)
+// for this purpose, but not all standard libraries implement it.
+//
+// Every value must lie between 0 and `max_value`. If the values are
+// not bounded, each task can count into a
+// [`std::unordered_map`](cpp/container/unordered_map) instead, at the
+// cost of slower increments.
@@ -0,0 +1,60 @@
+// Count values in a large range in parallel
+// C++17
+
+#include <algorithm>
+#include <execution>
+#include <vector>
+
+int main()
+{
+  std::vector<int> numbers(10'000'000, 1);
+
+  long long threes = std::count(std::execution::par_unseq,
+                                std::begin(numbers),
+                                std::end(numbers),
+                                3);
+
+  long long evens = std::count_if(std::execution::par_unseq,
+                                  std::begin(numbers),
+                                  std::end(numbers),
+                                  [](int i) { return i%2 == 0; });
+}
+
+// Count the occurrences of a value in a very large range using
+// multiple threads and vector instructions.
+//
+// On [10], we create a [`std::vector`](cpp/container/vector) of ten
+// million `int`s. For a range this size, a simple
+// [count](/patterns/count-values-in-range.html) with one element per
+// loop iteration leaves most of the processor unused.
+//
+// On [12-15], we call [`std::count`](cpp/algorithm/count) as
+// usual, but we pass an [execution
+// policy](cpp/algorithm/execution_policy_tag_t) as the first
+// argument. The [`std::execution::par_unseq`](cpp/algorithm/execution_policy_tag)
+// policy permits the implementation to split the range into chunks
+// that are counted on different threads and, within each chunk, to
+// process several elements at once with
+// [SIMD](https://en.wikipedia.org/wiki/SIMD) instructions. The
+// standard library chooses the instructions supported by the target
+// processor, so we do not need to write a separate version of the
+// loop for each instruction set.
+//
+// [!17-20] do the same for a predicate with
+// [`std::count_if`](cpp/algorithm/count). Under `par_unseq`, the
+// predicate may be called concurrently and interleaved on the same
+// thread, so it must not lock a mutex or modify shared state.
+//
+// We store the result in a `long long` because a range of several
+// billion elements may contain more matches than an `int` can
+// represent.
+//
+// Parallel execution has a start-up cost, so for small ranges the
+// plain sequential call is usually faster. As with any
+// optimization, we should [measure the execution
+// time](/patterns/measure-execution-time.html) of both forms on
+// realistic data before choosing one.
+//
+// **Note**: With GCC, the parallel algorithms run on Intel TBB
+// and need `-ltbb` at link time. Without TBB they fall back to
+// sequential execution.
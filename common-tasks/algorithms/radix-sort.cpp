@@ -0,0 +1,112 @@
+// Sort integer and floating-point keys with radix sort
+// C++11
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+template <typename T, typename KeyFunc>
+void radix_sort(std::vector<T>& values, KeyFunc key)
+{
+  using key_type = decltype(key(values.front()));
+  static_assert(std::is_unsigned<key_type>::value,
+                "key must return an unsigned integer");
+
+  std::vector<T> buffer(values.size());
+
+  for (std::size_t shift = 0; shift < 8 * sizeof(key_type); shift += 8)
+  {
+    std::array<std::size_t, 257> offsets{};
+
+    for (const T& value : values)
+      ++offsets[((key(value) >> shift) & 0xFF) + 1];
+
+    std::partial_sum(std::begin(offsets), std::end(offsets),
+                     std::begin(offsets));
+
+    for (const T& value : values)
+      buffer[offsets[(key(value) >> shift) & 0xFF]++] = value;
+
+    values.swap(buffer);
+  }
+}
+
+std::uint32_t float_key(float f)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &f, sizeof(bits));
+
+  return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+int main()
+{
+  std::vector<std::uint32_t> ints = {3, 4, 1, 5, 2};
+  std::vector<std::uint64_t> ids = {1ull << 40, 7, 1ull << 33, 2};
+  std::vector<float> floats = {0.5f, -2.0f, 3.25f, -0.0f, 1.0f};
+
+  radix_sort(ints, [](std::uint32_t i) { return i; });
+  radix_sort(ids, [](std::uint64_t i) { return i; });
+  radix_sort(ints, [](std::uint32_t i) { return ~i; });
+  radix_sort(floats, float_key);
+}
+
+// Sort a large range of numeric keys in linear time.
+//
+// [`std::sort`](cpp/algorithm/sort) is a comparison sort, so it
+// needs O(n log n) comparisons regardless of the type of element. When
+// each element can be mapped to an unsigned integer key whose order
+// matches the order we want, [radix
+// sort](https://en.wikipedia.org/wiki/Radix_sort) sorts in O(n) time
+// instead.
+//
+// The `radix_sort` function template on [12-36] performs a least
+// significant digit radix sort over the keys returned by the function
+// `key`. On [15-17], we determine the type of key and check that it
+// is an unsigned integer type. The function treats each key as a
+// sequence of 8-bit digits and sorts the elements by one digit per
+// pass, starting with the lowest, on [21-35]. The number of passes is
+// the number of bytes in the key, so 32-bit keys take four passes and
+// 64-bit keys take eight. Each pass is a [counting
+// sort](https://en.wikipedia.org/wiki/Counting_sort):
+//
+// 1. On [25-26], we count how many elements have each digit value.
+//    The count for digit `d` is stored at index `d + 1`.
+// 2. On [28-29], we use [`std::partial_sum`](cpp/algorithm/partial_sum)
+//    to turn the counts into offsets, so that `offsets[d]` is the
+//    position of the first element with digit `d`.
+// 3. On [31-32], we copy each element to the next free position for
+//    its digit in the scratch `buffer` created on [19].
+//
+// Each pass is stable, which means elements with equal digits keep
+// their relative order. This is what allows the later passes to
+// preserve the work of the earlier ones. On [34], we swap the
+// buffer with `values` so that the next pass reads the
+// partially sorted elements. After the last pass, the sorted elements
+// are therefore in `values`.
+//
+// On [52], we sort unsigned integers in ascending order by using each
+// value as its own key. On [53], we sort 64-bit integers in the same
+// way. To sort in descending order, as
+// [`std::greater`](cpp/utility/functional/greater) would with
+// `std::sort`, we invert the bits of the key on [54], which reverses
+// the order of keys while keeping the sort stable.
+//
+// Floating-point values cannot be used as keys directly, since
+// negative numbers have the sign bit set and their remaining bits
+// count in the wrong direction. The `float_key` function on [38-44]
+// copies the bits of an IEEE 754 `float` into an integer with
+// [`std::memcpy`](cpp/string/byte/memcpy) and then flips all of the
+// bits of negative numbers and only the sign bit of positive numbers.
+// The resulting keys compare in the same order as the original
+// numbers, which we use to sort `floats` on [55]. Signed integers
+// can be handled similarly by flipping only the sign bit.
+//
+// Each pass reads the whole range twice and writes it once, so for
+// small ranges, or for keys with many bytes, `std::sort` is usually
+// faster. Radix sort tends to pay off for ranges of many thousands of
+// elements or more.
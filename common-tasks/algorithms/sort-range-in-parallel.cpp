@@ -0,0 +1,81 @@
+// Sort a range of elements in parallel
+// C++11
+
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+
+template <typename RandomIt, typename Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp,
+                   unsigned tasks)
+{
+  if (tasks <= 1 || last - first < 10000)
+  {
+    std::sort(first, last, comp);
+    return;
+  }
+
+  RandomIt middle = first + (last - first) / 2;
+
+  std::future<void> left =
+    std::async(std::launch::async,
+               parallel_sort<RandomIt, Compare>,
+               first, middle, comp, tasks / 2);
+  parallel_sort(middle, last, comp, tasks - tasks / 2);
+  left.get();
+
+  std::inplace_merge(first, middle, last, comp);
+}
+
+int main()
+{
+  std::vector<int> vec(1000000);
+  unsigned tasks = std::thread::hardware_concurrency();
+
+  parallel_sort(std::begin(vec), std::end(vec),
+                std::greater<int>{}, tasks);
+}
+
+// Sort a large range of elements using multiple threads.
+//
+// The `parallel_sort` function template on [10-30] is a parallel
+// [merge sort](https://en.wikipedia.org/wiki/Merge_sort). It takes
+// the same iterator and comparison arguments as
+// [`std::sort`](cpp/algorithm/sort), plus the number of tasks that
+// it may split the work into.
+//
+// If only a single task remains, or the range is too small for
+// splitting to be worthwhile, we simply sort it with `std::sort` on
+// [14-18]. Otherwise, we split the range in half on [20]. On [22-25],
+// we use [`std::async`](cpp/thread/async) with
+// [`std::launch::async`](cpp/thread/launch) to sort the left half on
+// a new thread, giving it half of the remaining tasks. Meanwhile, we
+// sort the right half on the current thread with a recursive call on
+// [26]. Since each level of recursion halves the number of tasks,
+// no more than `tasks` threads will be sorting at the same time.
+//
+// On [27], we wait for the left half to finish by calling `get` on
+// its [`std::future`](cpp/thread/future), which also rethrows any
+// exception thrown while sorting it. Finally, on [29], we call
+// [`std::inplace_merge`](cpp/algorithm/inplace_merge) to merge the
+// two sorted halves into one sorted range, using the same comparison
+// function.
+//
+// In `main`, we ask for one task per hardware thread with
+// [`std::thread::hardware_concurrency`](cpp/thread/thread/hardware_concurrency)
+// on [35] and sort into descending order by passing
+// [`std::greater<int>`](cpp/utility/functional/greater) on [37-38],
+// exactly as we would with `std::sort`.
+//
+// The final merges run on fewer threads than the initial sorts, so
+// the speedup grows more slowly than the number of threads. For
+// very large ranges, a [sample
+// sort](https://en.wikipedia.org/wiki/Samplesort) partitions the
+// range first so that no merging is needed.
+//
+// **Note**: In C++17, we can instead pass the
+// [`std::execution::par`](cpp/algorithm/execution_policy_tag)
+// execution policy as the first argument to `std::sort` and let the
+// standard library parallelize the sort.
@@ -0,0 +1,87 @@
+// Swap large blocks of trivially copyable data
+// C++11
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+template <typename T>
+void swap_blocks(T* first1, T* first2, std::size_t count)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+  const std::size_t width = 32;
+
+  unsigned char* bytes1 = reinterpret_cast<unsigned char*>(first1);
+  unsigned char* bytes2 = reinterpret_cast<unsigned char*>(first2);
+  std::size_t size = count * sizeof(T);
+  std::size_t offset = 0;
+
+  for (; offset + width <= size; offset += width)
+  {
+    unsigned char a[width];
+    unsigned char b[width];
+
+    std::memcpy(a, bytes1 + offset, width);
+    std::memcpy(b, bytes2 + offset, width);
+    std::memcpy(bytes1 + offset, b, width);
+    std::memcpy(bytes2 + offset, a, width);
+  }
+
+  std::swap_ranges(bytes1 + offset, bytes1 + size, bytes2 + offset);
+}
+
+int main()
+{
+  std::vector<float> state1(1000000, 1.0f);
+  std::vector<float> state2(1000000, 2.0f);
+
+  swap_blocks(state1.data(), state2.data(), state1.size());
+}
+
+// Swap the contents of two large, non-overlapping blocks of memory
+// when their storage cannot simply be exchanged.
+//
+// Usually, the fastest way to [swap two
+// containers](/patterns/swap-containers.html) is to swap their
+// internal storage, which takes constant time. Sometimes, however,
+// the data must stay where it is, such as when other code holds
+// pointers into it. We then need to swap the contents of the blocks
+// themselves, as [`std::swap_ranges`](cpp/algorithm/swap_ranges) does.
+// `std::swap_ranges` swaps one element at a time, and compilers
+// do not always turn that loop into wide vector instructions.
+//
+// The `swap_blocks` function template on [10-35] swaps `count`
+// elements starting at `first1` with the elements starting at
+// `first2`. We use `static_assert` on [13-14] to accept only
+// [trivially copyable](cpp/types/is_trivially_copyable) element
+// types, whose values can be copied byte-by-byte. On [18-20], we
+// view both blocks as arrays of `unsigned char`, which is permitted
+// for any object type.
+//
+// On [23-32], we swap the blocks in chunks of `width` bytes, which we
+// set to 32 on [16]. For each chunk, we copy the bytes of both blocks
+// into the small arrays `a` and `b` on [28-29], and then copy them
+// back into the opposite blocks on [30-31]. Each byte is therefore
+// read once and written once, which is the least that any swap can
+// do. Because the size passed to
+// [`std::memcpy`](cpp/string/byte/memcpy) is a constant known at
+// compile time, compilers do not call a library function. Instead,
+// they replace each `std::memcpy` with a single load or store of a
+// 32-byte vector register, or two of 16 bytes, and `a` and `b` never
+// need to be stored in memory at all. On [34], we swap the fewer than
+// `width` bytes that remain with `std::swap_ranges`.
+//
+// Whether this is faster than `std::swap_ranges` depends on the
+// compiler and the optimization level. Some compilers already
+// vectorize the element-wise loop when optimizing aggressively, in
+// which case `std::swap_ranges` is just as fast. We should
+// [measure the execution time](/patterns/measure-execution-time.html)
+// of both before choosing this approach.
+//
+// In `main`, we use this on [42] to swap the contents of two large
+// `std::vector<float>`s without changing which storage belongs to
+// which vector. The two blocks must not overlap.
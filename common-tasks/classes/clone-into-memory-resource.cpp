@@ -0,0 +1,92 @@
+// Clone objects into a memory resource
+// C++17
+
+#include <memory_resource>
+#include <new>
+
+class Base
+{
+public:
+  virtual ~Base() {}
+
+  virtual Base* clone(std::pmr::memory_resource& resource) const = 0;
+};
+
+class Derived : public Base
+{
+public:
+  Derived* clone(std::pmr::memory_resource& resource) const override
+  {
+    void* memory = resource.allocate(sizeof(Derived), alignof(Derived));
+    Derived* copy = new (memory) Derived(*this);
+
+    if (child)
+      copy->child = child->clone(resource);
+
+    return copy;
+  }
+
+  const Base* child = nullptr;
+};
+
+void foo(const Base& original)
+{
+  std::pmr::monotonic_buffer_resource arena;
+
+  Base* copy = original.clone(arena);
+
+  // Use copy...
+}
+
+// Copy a graph of polymorphic objects into a single region of memory
+// that can be released all at once.
+//
+// The [virtual constructor idiom](/patterns/virtual-constructor.html)
+// lets us copy an object through a pointer to its base class, but
+// each copy is allocated separately with `new`. When we copy a large
+// graph of objects, such as a tree, this means one allocation for
+// every object, and one deallocation for every object when we
+// destroy the copy.
+//
+// Here, the `clone` member function declared on [12] takes a
+// [`std::pmr::memory_resource`](cpp/memory/memory_resource), which
+// represents a source of memory, and creates the copy in memory
+// obtained from it. The `Derived` class implements `clone` on
+// [18-27]. On [20], we ask `resource` for memory of the right size
+// and alignment for a `Derived` by calling its
+// [`allocate`](cpp/memory/memory_resource/allocate) member function.
+// On [21], we copy `*this` into that memory with
+// [placement new](cpp/language/new#Placement_new).
+//
+// Objects in the graph may refer to other objects, such as `child`
+// on [29]. On [23-24], we clone the child into the same `resource`,
+// so that the whole graph is copied into the same memory resource.
+//
+// In `foo`, we create a
+// [`std::pmr::monotonic_buffer_resource`](cpp/memory/monotonic_buffer_resource)
+// on [34]. This memory resource hands out memory from large blocks
+// by simply advancing a pointer, which is much faster than a general
+// allocation. It never reuses memory that has been deallocated.
+// Instead, it releases all of its blocks at once when it is
+// destroyed. On [36], we clone `original` into it.
+//
+// When `foo` returns, `arena` is destroyed and all memory used by
+// the copied graph is released, without visiting each object.
+// However, this does not call the objects' destructors. This is fine
+// as long as the objects own nothing other than memory from the same
+// arena, as is the case here. Otherwise, we must explicitly call the
+// destructor of every object in the copied graph before the arena is
+// destroyed. Calling `copy->~Base()` alone destroys only the root of
+// the graph, so `Derived`'s destructor would also have to destroy its
+// cloned `child`. In that case, it would need to know whether its
+// `child` is a clone, since the `child` of the original is not owned
+// by it.
+
+int main()
+{
+  Derived leaf;
+  Derived root;
+  root.child = &leaf;
+
+  foo(root);
+}
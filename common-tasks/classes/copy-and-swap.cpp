@@ -78,7 +78,8 @@ class foo
 // because all allocations (if any) occur when copying into the
 // `other` argument, before any changes have been made to `*this`.
 // It is generally, however, less optimized than a more custom
-// implementation of the assignment operators.
+// implementation of the assignment operators, such as one that
+// [reuses existing resources](/patterns/reuse-resources-on-assignment.html).
 //
 // **Note**: We can typically avoid manual memory management and
 // having to write the copy/move constructors, assignment operators,
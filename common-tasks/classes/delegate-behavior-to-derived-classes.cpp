@@ -71,6 +71,10 @@ void use(base<derived>& b)
 // `base<foo>` is provided, for example, `foo`'s implementation ([24-27])
 // will be invoked. For a `base<bar>`, on the other hand, the
 // default implementation defined by `base` will be used ([15-18]).
+//
+// **Note**: To call the right implementation for each object in a
+// collection of several different types, we can instead [dispatch
+// over a closed set of types](/patterns/dispatch-with-variant.html).
 
 int main()
 {
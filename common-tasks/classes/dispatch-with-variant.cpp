@@ -0,0 +1,88 @@
+// Dispatch over a closed set of types
+// C++17
+
+#include <variant>
+#include <vector>
+
+class foo
+{
+  public:
+    void do_something()
+    {
+      // Foo implementation
+    }
+};
+
+class bar
+{
+  public:
+    void do_something()
+    {
+      // Bar implementation
+    }
+};
+
+using element = std::variant<foo, bar>;
+
+int main()
+{
+  std::vector<element> elements = {foo{}, bar{}, foo{}};
+
+  for (element& e : elements)
+  {
+    std::visit([](auto& x) { x.do_something(); }, e);
+  }
+}
+
+// Call the right implementation for each object in a collection of
+// different types, without virtual functions or separate allocations.
+//
+// [Delegating behavior with CRTP](/patterns/delegate-behavior-to-derived-classes.html)
+// avoids the cost of run-time polymorphism, but only works when the
+// type of each object is known at compile time. When a collection
+// holds objects of several different types, we must choose the
+// implementation to call at run time. The usual approach is a
+// container of pointers to a base class with `virtual` functions.
+// This requires a separate allocation for each object, and each call
+// follows a pointer to the object and then a pointer to its function.
+//
+// When the set of types is fixed and known in advance, we can
+// instead use [`std::variant`](cpp/utility/variant). The classes
+// `foo` and `bar` on [7-23] have a member function with the same name,
+// `do_something`, but are otherwise unrelated. They do not share a
+// base class and their functions are not `virtual`. On [25], we
+// declare `element` as a variant that holds either a `foo` or a `bar`.
+//
+// On [29], we create a [`std::vector`](cpp/container/vector) of
+// `element`s. Each variant stores its object directly, so all of the
+// objects live next to each other in the vector's storage, without
+// any separate allocations.
+//
+// On [31-34], we iterate over the elements and call
+// [`std::visit`](cpp/utility/variant/visit) on each. `std::visit`
+// calls the given function object with whichever type the variant
+// currently holds. We pass a generic lambda whose `auto&` parameter
+// accepts either type, so it calls `foo::do_something` or
+// `bar::do_something` as appropriate. The compiler can see both
+// implementations at the call site and may inline them.
+//
+// A third option is to store a small integer tag with each object
+// and use it to index an array of function pointers, one for each
+// type. Standard library implementations of `std::visit` often work
+// in a similar way, although compilers may turn them into a `switch`
+// or inline the implementations instead.
+//
+// Each of these approaches still chooses the implementation at run
+// time, so its cost depends on how well the processor can predict
+// which implementation is called next, as well as on the compiler
+// and the size of the objects. A collection in which objects of the
+// same type are grouped together is usually easier to predict than
+// one with types in a random order. We should [measure the execution
+// time](/patterns/measure-execution-time.html) with realistic data
+// before choosing between them. Profilers such as `perf` on Linux can
+// also count the branch mispredictions.
+//
+// **Note**: Adding a new type to `element` requires changing its
+// definition, and every visitor must handle the new type. If new
+// types must be added without changing existing code, `virtual`
+// functions remain the better choice.
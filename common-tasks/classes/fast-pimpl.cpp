@@ -0,0 +1,124 @@
+// The fast PIMPL idiom
+// C++17
+
+// foo.h - header file
+
+#include <cstddef>
+
+class foo
+{
+  public:
+    foo();
+    ~foo();
+
+    foo(foo&&);
+    foo& operator=(foo&&);
+
+  private:
+    class impl;
+    impl& get();
+
+    static constexpr std::size_t impl_size = 16;
+    static constexpr std::size_t impl_align = 8;
+    alignas(impl_align) std::byte storage[impl_size];
+};
+
+
+// foo.cpp - implementation file
+
+#include <new>
+#include <utility>
+
+class foo::impl
+{
+  public:
+    void do_internal_work()
+    {
+      internal_data = 5;
+    }
+
+  private:
+    int internal_data = 0;
+};
+
+foo::foo()
+{
+  static_assert(sizeof(impl) <= impl_size, "impl_size is too small");
+  static_assert(alignof(impl) <= impl_align, "impl_align is too small");
+
+  new (storage) impl{};
+  get().do_internal_work();
+}
+
+foo::~foo()
+{
+  get().~impl();
+}
+
+foo::foo(foo&& other)
+{
+  new (storage) impl{std::move(other.get())};
+}
+
+foo& foo::operator=(foo&& other)
+{
+  get() = std::move(other.get());
+  return *this;
+}
+
+foo::impl& foo::get()
+{
+  return *std::launder(reinterpret_cast<impl*>(storage));
+}
+
+// Hide a class's internal implementation without allocating it on the
+// heap.
+//
+// The [PIMPL idiom](/patterns/pimpl.html) hides a class's private
+// members from its header file, but allocates its internal
+// implementation on the heap. Every object then costs a heap
+// allocation, and every access to the implementation follows a
+// pointer. The fast PIMPL idiom keeps the same compilation firewall
+// but stores the implementation inside the object itself.
+//
+// In the header file on [8-24], `foo` declares its implementation
+// class, `impl`, on [18] without defining it. Instead of a pointer,
+// it contains an array of bytes, `storage`, on [23]. The array is
+// large enough for an `impl` of up to `impl_size` bytes ([21]) and is
+// aligned with [`alignas`](cpp/language/alignas) to `impl_align`
+// bytes ([22]). These two numbers are the only details of `impl` that
+// users of the header can see.
+//
+// Since the compiler cannot check these numbers in the header, we
+// check them in the implementation file, where `impl` is complete. On
+// [46-47], we use `static_assert` to stop compilation if `impl` is
+// larger than `impl_size` or needs stricter alignment than
+// `impl_align`. If `impl` grows, we must increase these numbers in the
+// header, which causes users of `foo` to recompile. Making them
+// slightly larger than needed leaves room for growth.
+//
+// Because `storage` is just bytes, we must manage the lifetime of the
+// `impl` object that lives in it ourselves. On [49], the constructor
+// creates an `impl` in `storage` with
+// [placement new](cpp/language/new#Placement_new), and on [55], the
+// destructor calls `impl`'s destructor explicitly. The move
+// constructor on [58-61] move-constructs a new `impl` in `storage`
+// from the other object's, while the move assignment operator on
+// [63-67] move-assigns to the existing one.
+//
+// All access to the implementation goes through `get` on [69-72].
+// It converts the address of `storage` into a pointer to `impl` and
+// passes it through [`std::launder`](cpp/utility/launder), which
+// tells the compiler that an `impl` object was created at that
+// address.
+//
+// **Note**: Unlike a `std::unique_ptr`, inline storage cannot be
+// moved by swapping pointers, so moving a `foo` moves each member of
+// `impl`. A moved-from `foo` still holds a valid, moved-from `impl`.
+
+int main()
+{
+  foo f;
+  foo g = std::move(f);
+  f = std::move(g);
+}
@@ -0,0 +1,111 @@
+// Normalized sort keys
+// C++20
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using sort_key = std::array<unsigned char, 13>;
+
+class foo
+{
+  public:
+    foo(int n_, char c_, double d_)
+      : n{n_}, c{c_}, d{d_}
+    {}
+
+    sort_key key() const
+    {
+      std::uint32_t n_bits = std::bit_cast<std::uint32_t>(n);
+      n_bits ^= 0x80000000u;
+
+      unsigned char c_bits = static_cast<unsigned char>(c);
+      if constexpr (std::is_signed_v<char>)
+        c_bits ^= 0x80;
+
+      std::uint64_t d_bits = std::bit_cast<std::uint64_t>(d);
+      d_bits = (d_bits >> 63) ? ~d_bits : d_bits | (1ull << 63);
+
+      sort_key k;
+      for (int i = 0; i < 4; ++i)
+        k[i] = static_cast<unsigned char>(n_bits >> (24 - 8 * i));
+      k[4] = c_bits;
+      for (int i = 0; i < 8; ++i)
+        k[5 + i] = static_cast<unsigned char>(d_bits >> (56 - 8 * i));
+
+      return k;
+    }
+
+  private:
+    int n;
+    char c;
+    double d;
+};
+
+int main()
+{
+  std::vector<foo> foos = {{1, 'b', 2.78}, {1, 'a', 3.14},
+                           {-4, 'c', 0.5}};
+
+  std::vector<std::pair<sort_key, std::size_t>> keys;
+  for (std::size_t i = 0; i < foos.size(); ++i)
+    keys.emplace_back(foos[i].key(), i);
+
+  std::sort(std::begin(keys), std::end(keys));
+}
+
+// Encode the members of an object into a single key that compares
+// in the same order as the members would compare lexicographically.
+//
+// A [lexicographic ordering](/patterns/lexicographic-ordering.html)
+// over several members compares the first members, then the second
+// members if the first are equal, and so on. Each comparison may take
+// several branches. When sorting or searching a large number of
+// objects, we can instead convert each object once into a *normalized
+// key*: a sequence of bytes whose order, compared byte by byte, is the
+// same as the order of the objects.
+//
+// The class `foo` on [15-48] has three members of different types on
+// [45-47]. Its `key` member function on [22-42] encodes them into a
+// `sort_key` ([13]), an array of 13 bytes: four for `n`, one for `c`,
+// and eight for `d`. Each member is converted into an unsigned
+// integer whose order matches the member's order, and then written
+// most significant byte first, so that earlier bytes take precedence
+// over later ones.
+//
+// - For the `int` `n`, we copy its bits into an unsigned integer with
+//   [`std::bit_cast`](cpp/numeric/bit_cast) on [24] and flip the sign
+//   bit on [25]. This moves negative numbers below positive ones.
+// - For the `char` `c`, on [27-29], we do the same, but only if `char`
+//   is a signed type on the current platform. This is known at
+//   compile time, so we check it with `if constexpr`.
+// - For the `double` `d`, on [31-32], we flip all of the bits of
+//   negative numbers and only the sign bit of positive numbers, which
+//   orders [IEEE 754](https://en.wikipedia.org/wiki/IEEE_754) values
+//   correctly.
+//
+// On [34-39], we write these into the key, one byte at a time.
+//
+// In `main`, we compute the key of each `foo` once on [55-57] and pair
+// it with the index of the `foo` that it came from. On [59], we sort
+// the pairs. Comparing two `std::array`s of `unsigned char` is
+// equivalent to comparing their bytes with
+// [`std::memcmp`](cpp/string/byte/memcmp), which standard library
+// implementations typically use. Afterwards, the indices give the
+// `foo`s in sorted order. Since a normalized key is just a sequence of
+// bytes, we could also sort the keys without comparisons. The
+// [radix sort](/patterns/radix-sort.html) pattern only handles keys
+// that fit in a single unsigned integer, so keys longer than 8 bytes,
+// like these, need a most significant digit radix sort instead. Such
+// a sort splits the elements into buckets by their first byte, then
+// sorts each bucket by the next byte, and so on.
+//
+// **Note**: The keys for `0.0` and `-0.0` differ, even though the two
+// values compare equal, and NaN values, which are unordered, are
+// given a position. If these cases matter, `d` must be adjusted
+// before it is encoded.
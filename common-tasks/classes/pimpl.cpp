@@ -77,6 +77,9 @@ foo& foo::operator=(foo&&) = default;
 //
 // **Note**: `std::make_unique` was introduced in C++14. For C++11,
 // you can [roll your own implementation](http://stackoverflow.com/a/17902439/150634).
+//
+// **Note**: To avoid the heap allocation for `impl`, we can use the
+// [fast PIMPL idiom](/patterns/fast-pimpl.html) instead.
 
 int main()
 {
@@ -0,0 +1,105 @@
+// Reuse resources on copy assignment
+// C++11
+
+#include <utility>
+
+class resource {
+  int x = 0;
+};
+
+class foo
+{
+  public:
+    foo()
+      : p{new resource{}}
+    { }
+
+    foo(const foo& other)
+      : p{new resource{*(other.p)}}
+    { }
+
+    foo(foo&& other)
+      : p{other.p}
+    {
+      other.p = nullptr;
+    }
+
+    foo& operator=(const foo& other)
+    {
+      if (p) {
+        *p = *(other.p);
+      } else {
+        foo copy{other};
+        swap(*this, copy);
+      }
+
+      return *this;
+    }
+
+    foo& operator=(foo&& other)
+    {
+      swap(*this, other);
+
+      return *this;
+    }
+
+    ~foo()
+    {
+      delete p;
+    }
+
+    friend void swap(foo& first, foo& second)
+    {
+      using std::swap;
+
+      swap(first.p, second.p);
+    }
+
+  private:
+    resource* p;
+};
+
+// Avoid allocating a new resource on every copy assignment by
+// assigning to the resource that the object already owns.
+//
+// The [copy-and-swap idiom](/patterns/copy-and-swap.html) implements
+// copy assignment by copying the argument into a new object and then
+// swapping. This means that every copy assignment allocates a new
+// `resource`, even when the object being assigned to already owns one
+// that could simply be overwritten. If objects are assigned to
+// frequently, these allocations can dominate the cost of assignment.
+//
+// The class `foo`, on [10-60], manages a dynamically allocated
+// `resource` in the same way as the copy-and-swap example, but has
+// separate copy and move assignment operators. In the copy
+// assignment operator on [27-37], we check on [29] whether `*this`
+// already owns a `resource`. If it does, we assign the other object's
+// `resource` to it on [30], which performs no allocation. This also
+// handles self-assignment correctly, without a separate check.
+//
+// An object that has been moved from no longer owns a `resource`, so
+// in that case we fall back to copy-and-swap on [32-33]: we copy
+// `other` into a temporary object and swap `*this` with it.
+//
+// The move assignment operator on [39-44] simply swaps `*this` with
+// `other`. `other` takes ownership of the `resource` that `*this`
+// previously owned and releases it when it is destroyed, so moving
+// never allocates.
+//
+// The trade-off is exception safety. With copy-and-swap, all
+// allocations happen before `*this` is modified, which gives the
+// strong exception guarantee. When we assign to the existing
+// `resource` instead, `foo`'s copy assignment is only as exception
+// safe as `resource`'s copy assignment. If `resource`'s copy
+// assignment cannot throw, or itself provides the strong guarantee,
+// nothing is lost. Otherwise, a failed assignment may leave `*this`
+// partially modified, and we should keep copy-and-swap wherever the
+// strong guarantee is required.
+
+int main()
+{
+  foo f1, f2, f3;
+  f2 = f1;
+  f3 = std::move(f1);
+  f1 = f2;
+}
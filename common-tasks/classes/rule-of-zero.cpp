@@ -37,6 +37,10 @@ class bar
 // itself is not copyable. However, it correctly supports move
 // operations, which will transfer ownership of the dynamically
 // allocated resource.
+//
+// **Note**: Copying `foo` copies `v`, which allocates memory on the
+// heap. For short sequences, a [small vector](/patterns/small-vector.html)
+// can store its elements inside `foo` instead.
 
 int main()
 {
@@ -55,6 +55,10 @@ void foo(std::unique_ptr<Base> original)
 // is for `Derived::clone` to return a `Base` pointer instead.
 // Alternatively, you can provide non-virtual [wrapper
 // functions](http://stackoverflow.com/a/6925201/150634).
+//
+// **Note**: To copy a large graph of objects without allocating each
+// object separately, `clone` can instead [create the copy in a
+// memory resource](/patterns/clone-into-memory-resource.html).
 
 #include <utility>
 
@@ -0,0 +1,278 @@
+// Chain asynchronous tasks
+// C++17
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <typename T>
+class shared_state
+{
+  public:
+    void set_value(T v)
+    {
+      finish([&] { value.emplace(std::move(v)); });
+    }
+
+    void set_exception(std::exception_ptr e)
+    {
+      finish([&] { exception = e; });
+    }
+
+    void on_ready(std::function<void()> func)
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+
+      if (ready) {
+        lock.unlock();
+        func();
+      } else {
+        continuations.push_back(std::move(func));
+      }
+    }
+
+    const T& get()
+    {
+      std::unique_lock<std::mutex> lock{mutex};
+      ready_condition.wait(lock, [this] { return ready; });
+
+      if (exception)
+        std::rethrow_exception(exception);
+
+      return *value;
+    }
+
+  private:
+    template <typename Func>
+    void finish(Func store)
+    {
+      std::vector<std::function<void()>> next;
+
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        store();
+        ready = true;
+        next.swap(continuations);
+      }
+      ready_condition.notify_all();
+
+      for (std::function<void()>& func : next)
+        func();
+    }
+
+    std::mutex mutex;
+    std::condition_variable ready_condition;
+    bool ready = false;
+    std::optional<T> value;
+    std::exception_ptr exception;
+    std::vector<std::function<void()>> continuations;
+};
+
+template <typename T>
+using async_result = std::shared_ptr<shared_state<T>>;
+
+template <typename T, typename Func>
+void fulfil(shared_state<T>& state, Func& func)
+{
+  try {
+    state.set_value(func());
+  } catch (...) {
+    state.set_exception(std::current_exception());
+  }
+}
+
+template <typename Executor, typename Func>
+async_result<std::invoke_result_t<Func>>
+run_async(Executor& executor, Func func)
+{
+  using result = std::invoke_result_t<Func>;
+  async_result<result> state = std::make_shared<shared_state<result>>();
+
+  executor.execute([state, func]() mutable { fulfil(*state, func); });
+
+  return state;
+}
+
+template <typename T, typename Executor, typename Func>
+async_result<std::invoke_result_t<Func, T>>
+then(async_result<T> previous, Executor& executor, Func func)
+{
+  using result = std::invoke_result_t<Func, T>;
+  async_result<result> state = std::make_shared<shared_state<result>>();
+
+  previous->on_ready([previous, &executor, state, func] {
+    executor.execute([previous, state, func]() mutable {
+      auto next = [&previous, &func] { return func(previous->get()); };
+      fulfil(*state, next);
+    });
+  });
+
+  return state;
+}
+
+template <typename T>
+async_result<std::vector<T>>
+when_all(std::vector<async_result<T>> inputs)
+{
+  using result = std::vector<T>;
+  async_result<result> state = std::make_shared<shared_state<result>>();
+
+  std::shared_ptr<std::vector<async_result<T>>> all =
+    std::make_shared<std::vector<async_result<T>>>(std::move(inputs));
+  std::shared_ptr<std::atomic<std::size_t>> remaining =
+    std::make_shared<std::atomic<std::size_t>>(all->size());
+
+  if (all->empty())
+    state->set_value(result{});
+
+  for (const async_result<T>& input : *all)
+  {
+    input->on_ready([all, state, remaining] {
+      if (remaining->fetch_sub(1) != 1)
+        return;
+
+      auto collect = [&all] {
+        result values;
+        for (const async_result<T>& input : *all)
+          values.push_back(input->get());
+        return values;
+      };
+      fulfil(*state, collect);
+    });
+  }
+
+  return state;
+}
+
+class executor
+{
+  public:
+    void execute(std::function<void()> task);
+};
+
+int func()
+{
+  int some_value = 0;
+
+  // Do work...
+
+  return some_value;
+}
+
+int main()
+{
+  executor ex;
+
+  async_result<int> first = run_async(ex, func);
+
+  async_result<int> second =
+    then(first, ex, [](int value) { return value + 1; });
+
+  async_result<double> third =
+    then(second, ex, [](int value) { return value * 0.5; });
+
+  std::vector<async_result<int>> inputs = {first, second};
+  async_result<std::vector<int>> all = when_all(inputs);
+
+  // Do something...
+
+  double result = third->get();
+  std::vector<int> values = all->get();
+}
+
+// Start a task that runs when the result of another asynchronous task
+// becomes available, without blocking any thread while it waits.
+//
+// When we [execute a task asynchronously](/patterns/execute-task-asynchronously.html)
+// with [`std::async`](cpp/thread/async), we can only get its result
+// by calling `get` on the returned
+// [`std::future`](cpp/thread/future), which blocks until the result
+// is ready. If another task depends on this result, some thread has
+// to sit in `get` until the first task finishes, and `std::async`
+// typically starts a new thread for every call. A chain of 1000
+// dependent tasks would then hold 1000 blocked threads. Instead, we
+// store the dependent task alongside the result and only hand it to
+// an *executor*, such as a
+// [thread pool](/patterns/thread-pool.html), once the result is set.
+//
+// The `shared_state` class template on [16-77] holds the result of a
+// task: either a value, in a [`std::optional`](cpp/utility/optional)
+// on [74], or an exception, in a
+// [`std::exception_ptr`](cpp/error/exception_ptr) on [75]. It also
+// holds a list of `continuations` on [76], which are functions to
+// call once the result is ready. The task sets the result with
+// `set_value` or `set_exception` ([20-28]). Both call `finish`
+// ([54-69]), which stores the result, marks the state as ready and
+// takes the continuations while holding the mutex, and then wakes up
+// any thread waiting in `get` and calls the continuations on [67-68].
+// `on_ready` on [30-40] registers a continuation, or calls it
+// straight away if the result is already available. Any number of
+// continuations can be registered on the same state. `get` on [42-51]
+// waits until the result is ready and then returns a reference to the
+// value or rethrows the exception. The value stays in the state, so
+// every consumer of the result sees the same value.
+//
+// The task and everyone who waits for its result share the state
+// through a [`std::shared_ptr`](cpp/memory/shared_ptr), which we
+// call `async_result` on [79-80].
+//
+// `run_async` on [92-102] creates a new state and asks `executor` to
+// run `func` on [99]. `fulfil` on [82-90] calls the function and
+// stores its value, or the exception that it throws, in the state.
+//
+// The `then` function template on [104-119] attaches a continuation
+// to the `previous` result. It creates a state for the continuation's
+// result on [109] and registers a small function with `on_ready` on
+// [111-116]. No thread waits for `previous`. Only once its value has
+// been set does this function submit a task to the executor, which
+// passes the value to `func` on [113]. By that time, `previous->get()`
+// returns immediately. If the previous task threw an exception, `get`
+// rethrows it, and `fulfil` stores it in the new state without
+// calling `func`.
+//
+// The `when_all` function template on [121-153] combines several
+// results into one result holding all of their values. It shares the
+// `inputs` and a counter of the results that are not yet ready
+// between the continuations that it registers on [136-150]. Each
+// continuation decrements the counter on [139]. The last one to do
+// so, which knows that every input is ready, collects the values on
+// [142-148] and stores them in the new state. If any input holds an
+// exception, `get` rethrows it and `fulfil` stores it instead. A
+// `when_any` function can be written in the same way, replacing the
+// counter with a flag that the first continuation to run sets with
+// [`exchange`](cpp/atomic/atomic/exchange).
+//
+// Any class with an `execute` member function, such as the `executor`
+// declared on [155-159], can run the tasks. In `main`, we start
+// `func` on [174] and then build a chain of two continuations on
+// [176-180]. On [182-183], we also combine the results of `first` and
+// `second` with `when_all`. Each of these calls returns immediately,
+// so the current thread is free to do other work until it needs the
+// final results on [187-188].
+//
+// **Note**: For simplicity, `shared_state` cannot hold `void`,
+// because `std::optional<void>` is not valid. Tasks that return
+// nothing can return an empty `struct` instead, or `shared_state` can
+// be specialized for `void` to store only the exception.
+//
+// **Note**: Each task and continuation is stored in a
+// [`std::function`](cpp/utility/functional/function), which may
+// allocate memory for it. Standard library implementations only store
+// very small function objects, typically no larger than two pointers,
+// inside the `std::function` itself. The functions here capture two
+// `std::shared_ptr`s and `func`, so they are usually allocated. To
+// avoid this, the executor can accept a function wrapper with a
+// larger internal buffer.
+
+void executor::execute(std::function<void()> task)
+{
+  task();
+}
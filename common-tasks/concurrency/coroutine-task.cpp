@@ -0,0 +1,165 @@
+// Write a coroutine task type
+// C++20
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+template <typename T>
+class task
+{
+  public:
+    struct promise_type;
+
+    struct final_awaiter
+    {
+      bool await_ready() noexcept { return false; }
+
+      std::coroutine_handle<>
+      await_suspend(std::coroutine_handle<promise_type> h) noexcept
+      {
+        return h.promise().continuation;
+      }
+
+      void await_resume() noexcept { }
+    };
+
+    struct promise_type
+    {
+      std::optional<T> value;
+      std::exception_ptr exception;
+      std::coroutine_handle<> continuation = std::noop_coroutine();
+
+      task get_return_object()
+      {
+        return task{
+          std::coroutine_handle<promise_type>::from_promise(*this)};
+      }
+
+      std::suspend_always initial_suspend() noexcept { return {}; }
+      final_awaiter final_suspend() noexcept { return {}; }
+
+      void return_value(T v) { value = std::move(v); }
+      void unhandled_exception()
+      {
+        exception = std::current_exception();
+      }
+    };
+
+    explicit task(std::coroutine_handle<promise_type> h)
+      : handle{h}
+    { }
+
+    task(task&& other) noexcept
+      : handle{std::exchange(other.handle, nullptr)}
+    { }
+
+    ~task()
+    {
+      if (handle)
+        handle.destroy();
+    }
+
+    bool await_ready() noexcept { return false; }
+
+    std::coroutine_handle<>
+    await_suspend(std::coroutine_handle<> awaiting) noexcept
+    {
+      handle.promise().continuation = awaiting;
+      return handle;
+    }
+
+    T await_resume()
+    {
+      if (handle.promise().exception)
+        std::rethrow_exception(handle.promise().exception);
+
+      return std::move(*handle.promise().value);
+    }
+
+    T get()
+    {
+      handle.resume();
+      return await_resume();
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle;
+};
+
+task<int> get_value()
+{
+  co_return 42;
+}
+
+task<int> foo()
+{
+  int value = co_await get_value();
+  co_return value + 1;
+}
+
+int main()
+{
+  task<int> t = foo();
+
+  int result = t.get();
+}
+
+// Write functions that can suspend while waiting for another
+// computation and resume where they left off, without blocking a
+// thread.
+//
+// A [coroutine](cpp/language/coroutines) is a function that can
+// suspend its execution and later be resumed. While a coroutine is
+// suspended, it does not occupy a thread, so a program can have many
+// more operations in progress than it has threads. The standard
+// library does not provide a return type for coroutines, so we write
+// our own: `task<T>` on [9-89], which represents a computation that
+// will eventually produce a value of type `T`.
+//
+// The compiler uses the nested `promise_type` ([28-48]) to decide how
+// a coroutine that returns a `task` behaves. `get_return_object` on
+// [34-38] creates the `task` that the caller receives, holding a
+// [`std::coroutine_handle`](cpp/coroutine/coroutine_handle) through
+// which the coroutine can be resumed. `initial_suspend` on [40]
+// returns [`std::suspend_always`](cpp/coroutine/suspend_always),
+// which makes the coroutine suspend immediately, before running any
+// of its body, so the task only starts when it is awaited. When the
+// coroutine executes `co_return`, the value is stored in the promise
+// by `return_value` on [43], and any exception that escapes the body
+// is stored by `unhandled_exception` on [44-47].
+//
+// A coroutine can `co_await` a `task`, as `foo` does on [98]. This
+// calls the task's `await_suspend` member function on [66-71], which
+// records the awaiting coroutine as the task's `continuation` and
+// returns the task's own handle. Returning a handle from
+// `await_suspend` makes the compiler resume that coroutine directly
+// in place of the current one, which is known as *symmetric
+// transfer*. Compilers implement this as a tail call, so unlike
+// calling `resume`, it does not grow the stack, and long chains of
+// awaiting tasks cannot overflow it. Some compilers only guarantee
+// this when optimizations are enabled.
+//
+// When the awaited coroutine finishes, its `final_suspend` on [41]
+// returns a `final_awaiter` ([15-26]). Its `await_suspend` on
+// [19-23] transfers control back to the continuation in the same way.
+// The awaiting coroutine then resumes and calls `await_resume` on
+// [73-79] to get the result, or to rethrow the exception. If no
+// coroutine is waiting, the continuation is
+// [`std::noop_coroutine`](cpp/coroutine/noop_coroutine) ([32]), which
+// simply returns to whoever resumed the task.
+//
+// The `task` owns its coroutine, so its destructor on [58-62]
+// destroys it. A `task` can be moved but not copied.
+//
+// In `main`, which cannot itself be a coroutine, we start `foo` by
+// calling `get` ([81-85]) on [106]. This resumes the coroutine, which
+// runs until it completes, and then returns its result. This only
+// works because every coroutine in this example completes without
+// waiting for another thread. To await operations that complete on
+// other threads, such as timers or I/O, the awaitable must arrange
+// for the waiting coroutine's handle to be resumed when the operation
+// completes, for example by submitting it to a
+// [thread pool](/patterns/thread-pool.html). `main` must then wait
+// until the task has finished.
@@ -0,0 +1,89 @@
+// Pass a value between threads without allocation
+// C++20
+
+#include <atomic>
+#include <functional>
+#include <optional>
+#include <thread>
+#include <utility>
+
+template <typename T>
+class oneshot
+{
+  public:
+    void set_value(T v)
+    {
+      value.emplace(std::move(v));
+      ready.store(true, std::memory_order_release);
+      ready.notify_one();
+    }
+
+    T get()
+    {
+      ready.wait(false, std::memory_order_acquire);
+      return std::move(*value);
+    }
+
+  private:
+    std::optional<T> value;
+    std::atomic<bool> ready{false};
+};
+
+void func(oneshot<int>& result) noexcept
+{
+  result.set_value(42);
+}
+
+int main()
+{
+  oneshot<int> result;
+
+  std::thread t{func, std::ref(result)};
+
+  int value = result.get();
+
+  t.join();
+}
+
+// Pass a single value from one thread to another without allocating
+// memory or locking a mutex.
+//
+// When we [pass values between threads](/patterns/pass-values-between-threads.html)
+// with [`std::promise`](cpp/thread/promise) and
+// [`std::future`](cpp/thread/future), the promise allocates a shared
+// state on the heap and typically synchronizes through a mutex and a
+// condition variable. When the thread waiting for the value outlives
+// the thread that provides it, we can avoid both.
+//
+// The `oneshot` class template on [10-30] holds space for a single
+// value of type `T`. Its value is stored inside the object in a
+// [`std::optional`](cpp/utility/optional) on [28], so it does not
+// need a separate allocation. `ready` on [29] is a
+// [`std::atomic<bool>`](cpp/atomic/atomic) that becomes `true` once
+// the value has been set.
+//
+// In `set_value` on [14-19], we first construct the value inside the
+// `std::optional` on [16]. On [17], we then set `ready` to `true`
+// with `std::memory_order_release`, which guarantees that another
+// thread that observes `true` also sees the stored value. On [18], we
+// call [`notify_one`](cpp/atomic/atomic/notify_one) to wake up a
+// thread that may be waiting for `ready` to change.
+//
+// In `get` on [21-25], we call [`wait`](cpp/atomic/atomic/wait) on
+// [23], which blocks for as long as `ready` is `false`, and then move
+// the value out of the `oneshot` on [24]. The standard library
+// implements `wait` and `notify_one` with efficient operating system
+// facilities, such as futexes on Linux, so no mutex is involved.
+//
+// In `main`, we create `result` on the stack on [39] and pass it by
+// reference to the thread running `func` on [41]. The thread sets the
+// value on [34], while `main` waits for it on [43].
+//
+// **Note**: `set_value` still accesses `ready` after the waiting
+// thread may have been woken up, so the `oneshot` must not be
+// destroyed until `set_value` has returned. Here, we ensure this by
+// joining the thread on [45] before `result` is destroyed.
+//
+// **Note**: Unlike `std::future`, `oneshot` does not support passing
+// an exception to the waiting thread, and `set_value` and `get` must
+// each be called exactly once.
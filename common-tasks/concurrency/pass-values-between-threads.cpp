@@ -39,3 +39,8 @@ int main()
 // value (or an exception) available. When the value is available
 // (that is, when the value of the promise has been set on [9]), it
 // will be returned by `get`.
+//
+// **Note**: A `std::promise` typically allocates memory for the state
+// that it shares with its future. If the waiting thread outlives the
+// thread that sets the value, we can instead [pass the value without
+// allocation](/patterns/pass-value-without-allocation.html).
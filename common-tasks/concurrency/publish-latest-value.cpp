@@ -0,0 +1,140 @@
+// Publish the latest value with a sequence lock
+// C++17
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+
+template <typename T>
+class latest_value
+{
+  static_assert(std::is_trivially_copyable_v<T>,
+                "T must be trivially copyable");
+  static_assert(std::is_default_constructible_v<T>,
+                "T must be default constructible");
+
+  public:
+    void store(const T& value)
+    {
+      std::array<std::uint64_t, word_count> words{};
+      std::memcpy(words.data(), &value, sizeof(T));
+
+      unsigned seq = sequence.load(std::memory_order_relaxed);
+      sequence.store(seq + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      for (std::size_t i = 0; i < word_count; ++i)
+        data[i].store(words[i], std::memory_order_relaxed);
+
+      sequence.store(seq + 2, std::memory_order_release);
+    }
+
+    T load() const
+    {
+      std::array<std::uint64_t, word_count> words;
+
+      while (true)
+      {
+        unsigned before = sequence.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < word_count; ++i)
+          words[i] = data[i].load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        unsigned after = sequence.load(std::memory_order_relaxed);
+
+        if (before == after && before % 2 == 0)
+          break;
+      }
+
+      T value;
+      std::memcpy(&value, words.data(), sizeof(T));
+      return value;
+    }
+
+  private:
+    static constexpr std::size_t word_count =
+      (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    std::atomic<unsigned> sequence{0};
+    std::array<std::atomic<std::uint64_t>, word_count> data{};
+};
+
+struct quote
+{
+  double bid;
+  double ask;
+  long long time;
+};
+
+int main()
+{
+  latest_value<quote> latest;
+
+  std::thread writer{[&latest] {
+    for (long long t = 0; t < 100000; ++t)
+      latest.store(quote{1.0, 1.5, t});
+  }};
+
+  quote q = latest.load();
+
+  writer.join();
+}
+
+// Let one thread repeatedly publish a small value while any number of
+// other threads read the most recent version, without ever blocking
+// the writer.
+//
+// When we [pass values between threads](/patterns/pass-values-between-threads.html),
+// each value is usually consumed exactly once. Sometimes, however,
+// readers only care about the most recent value, such as the latest
+// price of a stock. Protecting the value with a mutex would make the
+// writer wait for readers, and an atomic `std::shared_ptr` would
+// allocate memory for every update. A [sequence
+// lock](https://en.wikipedia.org/wiki/Seqlock) avoids both.
+//
+// The `latest_value` class template on [12-65] stores a value of any
+// [trivially copyable](cpp/types/is_trivially_copyable) type `T`,
+// split into 64-bit words held in the `data` array on [64]. We also
+// require `T` to be default constructible on [17-18], since `load`
+// creates a `T` before copying the words into it. Next to `data` is
+// a `sequence` number on [63], which is even when no write is in
+// progress and odd while the value is being written.
+//
+// The `store` member function on [21-34] must only be called by one
+// thread. On [23-24], we copy the bytes of the new value into an array
+// of words with [`std::memcpy`](cpp/string/byte/memcpy). On [26-28],
+// we make the sequence number odd, and use a
+// [fence](cpp/atomic/atomic_thread_fence) to make sure that this
+// happens before any of the words are changed. We then write each
+// word on [30-31], and finally make the sequence number even again on
+// [33]. The writer never waits for anything, no matter what the
+// readers are doing.
+//
+// The `load` member function on [36-57] may be called by any number
+// of threads at once. On [42-48], we read the sequence number, then
+// all of the words, and then the sequence number again. If both
+// sequence numbers are the same and even, no write happened while we
+// were reading, so the words form a consistent value. Otherwise, we
+// try again. Once we have a consistent copy, we convert it back into
+// a `T` on [54-56].
+//
+// Each word is a [`std::atomic`](cpp/atomic/atomic), so reading it
+// while another thread writes it is not a data race, even though the
+// reader may see a mix of old and new words. The sequence number
+// check ensures that such a mix is never returned. The acquire and
+// release operations on the sequence number, together with the
+// fences, ensure that a reader which sees the same even sequence
+// number twice has seen every word written before it.
+//
+// In `main`, a `writer` thread publishes many `quote`s ([67-72]) on
+// [78-81], while the main thread reads the most recent one on [83].
+//
+// **Note**: A reader must retry whenever a write overlaps its read, so
+// if the writer updates the value continuously, readers may have to
+// retry several times. Sequence locks are best suited to small
+// values that are read much more often than they are written.
@@ -0,0 +1,148 @@
+// Stream values between two threads
+// C++20
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+
+template <typename T, std::size_t Capacity>
+class spsc_queue
+{
+  public:
+    bool try_push(const T& value)
+    {
+      std::size_t tail = write_index.load(std::memory_order_relaxed);
+      if (tail - read_index.load(std::memory_order_acquire) == Capacity)
+        return false;
+
+      buffer[tail % Capacity] = value;
+      write_index.store(tail + 1, std::memory_order_release);
+      write_index.notify_one();
+      return true;
+    }
+
+    bool try_pop(T& value)
+    {
+      std::size_t head = read_index.load(std::memory_order_relaxed);
+      if (head == write_index.load(std::memory_order_acquire))
+        return false;
+
+      value = buffer[head % Capacity];
+      read_index.store(head + 1, std::memory_order_release);
+      read_index.notify_one();
+      return true;
+    }
+
+    void push(const T& value)
+    {
+      while (!try_push(value))
+      {
+        std::size_t tail = write_index.load(std::memory_order_relaxed);
+        read_index.wait(tail - Capacity, std::memory_order_acquire);
+      }
+    }
+
+    void pop(T& value)
+    {
+      while (!try_pop(value))
+      {
+        std::size_t head = read_index.load(std::memory_order_relaxed);
+        write_index.wait(head, std::memory_order_acquire);
+      }
+    }
+
+  private:
+    std::array<T, Capacity> buffer;
+    alignas(64) std::atomic<std::size_t> write_index{0};
+    alignas(64) std::atomic<std::size_t> read_index{0};
+};
+
+int main()
+{
+  spsc_queue<int, 1024> queue;
+
+  std::thread producer{[&queue] {
+    for (int i = 0; i < 100000; ++i)
+      queue.push(i);
+  }};
+
+  long long sum = 0;
+  for (int i = 0; i < 100000; ++i)
+  {
+    int value;
+    queue.pop(value);
+    sum += value;
+  }
+
+  producer.join();
+}
+
+// Pass a continuous stream of values from one thread to another
+// without locks or memory allocation.
+//
+// A [`std::promise`](/patterns/pass-values-between-threads.html)
+// passes a single value between threads and must allocate its shared
+// state and synchronize through it for each value. When one thread
+// produces a stream of values for another to consume, a bounded
+// queue with exactly one producer and one consumer can pass each value
+// with a few memory operations and no locks.
+//
+// The `spsc_queue` class template on [9-59] is a *ring buffer*: it
+// stores up to `Capacity` elements in a fixed-size
+// [`std::array`](cpp/container/array) on [56], reusing the
+// array's elements in a circle. `write_index` and `read_index` on
+// [57-58] count the total number of elements pushed and popped so
+// far. The element at position `i` in that sequence lives at index
+// `i % Capacity` of the array, and the number of elements in the
+// queue is `write_index - read_index`.
+//
+// Only the producer thread calls `try_push` ([13-23]) and only it
+// writes to `write_index`. Only the consumer thread calls `try_pop`
+// ([25-35]) and only it writes to `read_index`. This allows each
+// index to be a simple [`std::atomic`](cpp/atomic/atomic) that is
+// read by one thread and written by the other, so no
+// read-modify-write operations or locks are needed. If the queue is
+// full or empty, `try_push` or `try_pop` returns `false` immediately
+// ([16-17] and [28-29]), rather than waiting.
+//
+// The [memory orders](cpp/atomic/memory_order) make sure each
+// element is fully written before it is read. In `try_push`, we write
+// the element on [19] and only then publish it by storing the new
+// `write_index` with `std::memory_order_release` on [20]. The
+// consumer loads `write_index` with `std::memory_order_acquire` on
+// [28], which guarantees that it sees the element written before that
+// store. The same pairing on `read_index` ([32] and [16]) guarantees
+// that the producer does not overwrite an element before the consumer
+// has finished reading it.
+//
+// We use [`alignas`](cpp/language/alignas) on [57-58] to place each
+// index in its own 64-byte cache line. Otherwise, every write to one
+// index would force the other thread's processor core to reload the
+// cache line holding both, an effect known as [false
+// sharing](https://en.wikipedia.org/wiki/False_sharing).
+//
+// When a thread has nothing else to do while the queue is full or
+// empty, it can instead call the blocking `push` ([37-44]) or `pop`
+// ([46-53]). These call `try_push` or `try_pop` and, if it fails,
+// use [`wait`](cpp/atomic/atomic/wait) on [42] or [51] to sleep until
+// the other thread changes the index that it is waiting for. The
+// queue is full when `read_index` is exactly `Capacity` behind
+// `write_index`, and empty when both are equal, so these are the
+// values that we pass to `wait`. If the other thread has already
+// changed the index, `wait` returns immediately. Otherwise, it blocks
+// until `try_push` or `try_pop` on the other thread calls
+// [`notify_one`](cpp/atomic/atomic/notify_one) on [21] or [33] after
+// storing the new index. The standard library typically implements
+// `wait` and `notify_one` with efficient operating system facilities,
+// such as futexes on Linux, and `notify_one` does very little when no
+// thread is waiting.
+//
+// In `main`, a `producer` thread pushes values into `queue` on
+// [65-68] while the main thread pops them on [71-76], each waiting
+// whenever it gets ahead of the other.
+//
+// **Note**: This queue is only correct with a single producer and a
+// single consumer. Queues that allow several producers or consumers
+// must use compare-and-exchange operations on their indices, which
+// makes them considerably more complex.
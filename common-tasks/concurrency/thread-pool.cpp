@@ -0,0 +1,187 @@
+// Run tasks on a thread pool
+// C++17
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class thread_pool
+{
+  public:
+    explicit thread_pool(unsigned threads)
+    {
+      try {
+        for (unsigned i = 0; i < threads; ++i)
+          workers.emplace_back([this] { run(); });
+      } catch (...) {
+        stop();
+        throw;
+      }
+    }
+
+    ~thread_pool()
+    {
+      stop();
+    }
+
+    template <typename Func, typename... Args>
+    std::future<std::invoke_result_t<Func, Args...>>
+    submit(Func func, Args... args)
+    {
+      using result = std::invoke_result_t<Func, Args...>;
+      std::tuple<Args...> arguments{std::move(args)...};
+
+      std::shared_ptr<std::packaged_task<result()>> task =
+        std::make_shared<std::packaged_task<result()>>(
+          [func, arguments]() mutable {
+            return std::apply(func, std::move(arguments));
+          });
+      std::future<result> future = task->get_future();
+
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        tasks.push([task] { (*task)(); });
+      }
+      condition.notify_one();
+
+      return future;
+    }
+
+  private:
+    void stop()
+    {
+      {
+        std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+      }
+      condition.notify_all();
+
+      for (std::thread& worker : workers)
+        worker.join();
+    }
+
+    void run()
+    {
+      while (true)
+      {
+        std::function<void()> task;
+
+        {
+          std::unique_lock<std::mutex> lock{mutex};
+          condition.wait(lock, [this] {
+            return stopping || !tasks.empty();
+          });
+
+          if (tasks.empty())
+            return;
+
+          task = std::move(tasks.front());
+          tasks.pop();
+        }
+
+        task();
+      }
+    }
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+void func(std::string str, int& x);
+void do_something();
+
+int main()
+{
+  thread_pool pool{std::max(1u, std::thread::hardware_concurrency())};
+
+  std::string str = "Test";
+  int x = 5;
+
+  std::future<void> done = pool.submit(func, str, std::ref(x));
+
+  do_something();
+
+  done.get();
+}
+
+// Execute many small tasks concurrently without creating a thread
+// for each of them.
+//
+// [Creating a thread](/patterns/create-thread.html) takes far longer
+// than a function call. When we have many small tasks, starting a new
+// `std::thread` for each one can take longer than the tasks
+// themselves. A *thread pool* instead starts a fixed number of
+// threads once, and then hands tasks to them as they arrive.
+//
+// The `thread_pool` class on [18-101] starts `threads` worker threads
+// in its constructor on [21-30], each of which executes the `run`
+// member function. Tasks waiting to be executed are stored in the
+// `tasks` queue on [97]. The queue is shared by all threads, so it is
+// protected by `mutex` on [98].
+//
+// Each worker loops on [75-93]. On [81-83], it waits on the
+// [`std::condition_variable`](cpp/thread/condition_variable)
+// `condition` until there is a task in the queue or the pool is
+// stopping. It then takes the first task from the queue on [88-89]
+// and executes it on [92], after unlocking the mutex so that other
+// workers can take tasks at the same time.
+//
+// The `submit` member function on [37-58] takes a function and its
+// arguments, just like the constructor of
+// [`std::thread`](cpp/thread/thread). On [42-48], we wrap them in a
+// [`std::packaged_task`](cpp/thread/packaged_task), which stores
+// the result of the call, or any exception that it throws, for the
+// [`std::future`](cpp/thread/future) that we obtain on [49] and
+// return to the caller. The arguments are copied into a
+// [`std::tuple`](cpp/utility/tuple), and the function is called with
+// them by [`std::apply`](cpp/utility/apply). As with `std::thread`,
+// an argument is only passed by reference if it is wrapped with
+// [`std::ref`](cpp/utility/functional/ref), as we do for `x` on [113].
+// On [51-55], we add the task to the queue and wake up one waiting
+// worker. A `std::packaged_task` cannot be copied, but a
+// [`std::function`](cpp/utility/functional/function) must be, so we
+// hold the task through a [`std::shared_ptr`](cpp/memory/shared_ptr).
+//
+// The destructor on [32-35] calls `stop` ([61-71]), which sets
+// `stopping` and wakes up all of the workers. Each worker finishes
+// the tasks that remain in the queue and then returns from `run` on
+// [85-86]. `stop` waits for all of them with
+// [`join`](cpp/thread/thread/join).
+//
+// Starting a thread can fail, for example when the system has run out
+// of resources, in which case `emplace_back` throws a
+// [`std::system_error`](cpp/error/system_error). A constructor that
+// throws does not run the destructor, and destroying a `std::thread`
+// that has not been joined terminates the program. We therefore catch
+// the exception on [26-29], stop and join the workers that have
+// already started, and then rethrow it.
+//
+// In `main`, we create a pool with one worker for each hardware
+// thread on [108], submit a task on [113], and wait for it to complete
+// by calling `get` on the returned future on [117].
+//
+// **Note**: With many workers and very small tasks, the single shared
+// queue becomes a bottleneck, since every worker must lock the same
+// mutex. High-performance thread pools give each worker its own
+// queue and let idle workers steal tasks from the others'
+// queues, an approach known as
+// [work stealing](https://en.wikipedia.org/wiki/Work_stealing).
+
+void func(std::string, int&)
+{ }
+
+void do_something()
+{ }
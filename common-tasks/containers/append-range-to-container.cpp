@@ -0,0 +1,71 @@
+// Append a range of elements to a container
+// C++11
+
+#include <iterator>
+#include <vector>
+
+std::vector<int> target1;
+std::vector<int> target2;
+
+template <typename RangeOfInts>
+void foo(const RangeOfInts& source)
+{
+  target1.insert(std::end(target1),
+                 std::begin(source), std::end(source));
+}
+
+template <typename RangeOfInts>
+void bar(const RangeOfInts& source)
+{
+  target2.reserve(target2.size() + source.size());
+
+  for (int value : source)
+  {
+    target2.push_back(value * 2);
+  }
+}
+
+// Append all of the elements of a range to a container with as few
+// allocations as possible.
+//
+// When we [copy a range](/patterns/copy-range-of-elements.html) into
+// a container with [`std::back_inserter`](cpp/iterator/back_inserter),
+// the container only ever sees one element at a time. A
+// [`std::vector`](cpp/container/vector) must then grow its storage
+// several times as elements arrive, moving its existing elements each
+// time.
+//
+// In `foo` on [10-15], we instead pass the whole `source` range to the
+// vector's [`insert`](cpp/container/vector/insert) member function
+// on [13-14], inserting at the end of `target1`. When the iterators
+// are at least forward iterators, `insert` can measure the range
+// up front, allocate the required storage at most once, and copy the
+// elements in bulk. For a trivially copyable element type such as
+// `int` in contiguous storage, standard library implementations
+// perform this copy with a single call to
+// [`std::memmove`](cpp/string/byte/memmove). With only input
+// iterators, `insert` falls back to inserting one element at a time.
+//
+// Sometimes we cannot insert the range directly, such as when each
+// element must be transformed first. In `bar` on [17-26], we double
+// each element before appending it to `target2`. Since the number of
+// elements is known, we call
+// [`reserve`](cpp/container/vector/reserve) on [20] to allocate
+// storage for all of them before the loop. The calls to
+// [`push_back`](cpp/container/vector/push_back) on [24] then never
+// need to reallocate.
+//
+// **Note**: `reserve` requests exactly the capacity we ask for. If
+// we call `bar` repeatedly with small ranges, each call may
+// reallocate by only a few elements, defeating the geometric growth
+// that `push_back` normally provides. In that case, it is better to
+// reserve once for the total size, or not at all.
+
+#include <array>
+
+int main()
+{
+  std::array<int, 5> arr = {5, 4, 3, 2, 1};
+  foo(arr);
+  bar(arr);
+}
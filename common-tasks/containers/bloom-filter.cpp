@@ -0,0 +1,128 @@
+// Filter out missing keys with a Bloom filter
+// C++17
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class bloom_filter
+{
+  public:
+    bloom_filter(std::size_t expected_keys, double false_positive_rate)
+      : blocks(static_cast<std::size_t>(expected_keys *
+                 bits_per_key(false_positive_rate) / 512) + 1),
+        hashes{static_cast<int>(
+          std::lround(bits_per_key(false_positive_rate)
+                      * std::log(2.0)))}
+    { }
+
+    void insert(std::string_view key)
+    {
+      std::uint64_t h = std::hash<std::string_view>{}(key);
+      block& b = blocks[h % blocks.size()];
+
+      for (int i = 0; i < hashes; ++i)
+      {
+        h *= 0x9E3779B97F4A7C15u;
+        std::uint64_t bit = std::uint64_t{1} << ((h >> 55) & 63);
+        b.words[h >> 61] |= bit;
+      }
+    }
+
+    bool possibly_contains(std::string_view key) const
+    {
+      std::uint64_t h = std::hash<std::string_view>{}(key);
+      const block& b = blocks[h % blocks.size()];
+
+      for (int i = 0; i < hashes; ++i)
+      {
+        h *= 0x9E3779B97F4A7C15u;
+        std::uint64_t bit = std::uint64_t{1} << ((h >> 55) & 63);
+        if (!(b.words[h >> 61] & bit))
+          return false;
+      }
+
+      return true;
+    }
+
+  private:
+    struct alignas(64) block
+    {
+      std::array<std::uint64_t, 8> words{};
+    };
+
+    static double bits_per_key(double false_positive_rate)
+    {
+      return -std::log(false_positive_rate) /
+             (std::log(2.0) * std::log(2.0));
+    }
+
+    std::vector<block> blocks;
+    int hashes;
+};
+
+int main()
+{
+  std::map<std::string, int> m = {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  bloom_filter filter{m.size(), 0.01};
+  for (const std::pair<const std::string, int>& element : m)
+    filter.insert(element.first);
+
+  if (filter.possibly_contains("z") && m.count("z"))
+  {
+    // We know "z" is in m
+  }
+}
+
+// Answer most lookups of missing keys without searching the
+// container that holds the keys.
+//
+// A [Bloom filter](https://en.wikipedia.org/wiki/Bloom_filter) is a
+// compact, probabilistic summary of a set of keys. When we ask it
+// whether a key is in the set, it answers either "definitely not" or
+// "possibly". If we place one in front of a large associative
+// container and most of our lookups are for missing keys, the filter
+// can answer most of them without touching the container at all.
+//
+// The `bloom_filter` class on [15-69] stores its bits in `blocks`,
+// declared on [67]. Each `block` ([56-59]) holds 512 bits and is
+// aligned to 64 bytes with [`alignas`](cpp/language/alignas), which
+// is the size of a cache line on most processors. All of the bits for
+// a single key are placed in one block, so each insertion or lookup
+// reads only one cache line from memory. In exchange, the actual
+// false positive rate is slightly higher than for a filter whose bits
+// are spread across the whole array.
+//
+// The constructor on [18-24] sizes the filter for the number of keys
+// we expect to insert and the fraction of missing keys that we are
+// willing to have reported as "possibly" present. The
+// `bits_per_key` function on [61-65] computes how many bits per key
+// are needed to achieve this false positive rate. For a rate of 1%,
+// this is about 9.6 bits per key, regardless of the size of the keys.
+// The number of bits to set for each key, `hashes`, follows from the
+// same formula.
+//
+// To `insert` a key ([26-37]), we hash it with
+// [`std::hash`](cpp/utility/hash) and use the hash to choose a block
+// on [29]. On [31-36], we derive `hashes` further pseudo-random
+// values by repeatedly multiplying the hash by a large odd constant.
+// The top bits of each value choose one of the block's bits to set.
+// The `possibly_contains` member function on [39-53] repeats the same
+// steps, but returns `false` as soon as it finds a bit that is not
+// set on [48-49]. A key that was inserted always has all of its bits
+// set, so the filter never wrongly reports an inserted key as missing.
+//
+// In `main`, we construct a filter for the keys of `m` on [75-77]. On
+// [79], we only search `m` for a key if the filter reports that it
+// may be present. Since the filter is not updated automatically, we
+// must insert each new key into both the filter and the container.
+// Keys cannot be removed from a Bloom filter, so after many removals
+// from the container, the filter should be rebuilt.
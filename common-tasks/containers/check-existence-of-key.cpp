@@ -28,3 +28,7 @@ int main()
 // if the container's comparator is
 // [transparent](http://stackoverflow.com/q/20317413/150634) and
 // supports the appropriate comparison without conversions.
+//
+// Note: in C++20, associative containers also provide a `contains`
+// member function, and unordered containers can [look up keys
+// without conversions](/patterns/heterogeneous-lookup.html) too.
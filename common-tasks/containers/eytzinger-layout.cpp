@@ -0,0 +1,111 @@
+// Search a read-only sorted map in Eytzinger order
+// C++20
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class eytzinger_map
+{
+  public:
+    explicit eytzinger_map(std::vector<std::pair<int, int>> values)
+      : elements(values.size() + 1)
+    {
+      std::sort(std::begin(values), std::end(values));
+
+      std::size_t next = 0;
+      build(values, next, 1);
+    }
+
+    const int* find(int key) const
+    {
+      std::size_t k = 1;
+
+      while (k < elements.size())
+        k = 2 * k + (elements[k].first < key);
+
+      k >>= std::countr_one(k) + 1;
+
+      if (k == 0 || elements[k].first != key)
+        return nullptr;
+
+      return &elements[k].second;
+    }
+
+  private:
+    void build(const std::vector<std::pair<int, int>>& sorted,
+               std::size_t& next, std::size_t k)
+    {
+      if (k < elements.size())
+      {
+        build(sorted, next, 2 * k);
+        elements[k] = sorted[next++];
+        build(sorted, next, 2 * k + 1);
+      }
+    }
+
+    std::vector<std::pair<int, int>> elements;
+};
+
+int main()
+{
+  eytzinger_map m{{{3, 30}, {1, 10}, {4, 40}, {2, 20}, {5, 50}}};
+
+  if (const int* value = m.find(2))
+  {
+    // We know 2 is in m and *value is 20
+  }
+}
+
+// Look up keys in a map that is built once and then only read, with
+// fewer cache misses and mispredicted branches than a binary search.
+//
+// A [`std::map`](cpp/container/map) is usually a tree of separately
+// allocated nodes, so each step of a lookup follows a pointer to
+// somewhere else in memory. Storing the elements in a sorted
+// `std::vector` and searching it with
+// [`std::lower_bound`](cpp/algorithm/lower_bound) removes the
+// pointers, but the elements visited by a large binary search are
+// still far apart, and the direction of each step is hard for the
+// processor to predict.
+//
+// The `eytzinger_map` class on [10-50] instead stores its elements in
+// *Eytzinger order*, which is the order in which a breadth-first
+// traversal would visit a balanced binary search tree. The element at
+// index `k` of `elements` ([49]) is the root of a subtree whose
+// children are at indices `2k` and `2k + 1`; index 0 is unused. The
+// first few levels of the tree, which every lookup visits, are
+// therefore stored next to each other at the start of the vector,
+// where they tend to stay in the cache.
+//
+// The constructor on [13-20] sorts the given key-value pairs and
+// then calls `build` ([38-47]) to place them. `build` performs an
+// in-order traversal of the implicit tree, assigning the sorted
+// elements to the indices in the order it visits them. This makes
+// each left subtree hold smaller keys than its root, and each right
+// subtree larger ones.
+//
+// The `find` member function on [22-35] descends the tree from the
+// root at index 1 on [24-27]. At each step, we add the result of the
+// comparison `elements[k].first < key` to `2 * k`, moving to the left
+// child if the key is not greater than the current element and to the
+// right child otherwise. The loop has no branch that depends on the
+// comparison, and it always runs for the height of the tree, so the
+// processor can easily predict it.
+//
+// When the loop ends, `k` is past the end of the tree. The last time
+// we moved left was at the first element not less than `key`, as with
+// `std::lower_bound`. Each right move appended a 1 bit to `k` and
+// each left move a 0 bit. So on [29], we use
+// [`std::countr_one`](cpp/numeric/countr_one) to count the trailing
+// right moves and shift them off, along with the final left move. On
+// [31-34], we return a pointer to the element's value if its key is
+// equal to `key`, or `nullptr` otherwise.
+//
+// **Note**: Since the children of `k` are at a predictable position,
+// the loop can also ask the processor to fetch elements several
+// levels ahead before they are needed. Standard C++ does not provide
+// this, but most compilers offer it as an extension, such as
+// `__builtin_prefetch` in GCC and Clang.
@@ -0,0 +1,73 @@
+// Look up string keys without creating strings
+// C++20
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+struct string_hash
+{
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view str) const noexcept
+  {
+    return std::hash<std::string_view>{}(str);
+  }
+};
+
+int main()
+{
+  std::unordered_map<std::string, int, string_hash, std::equal_to<>> m =
+    {{"a", 1}, {"b", 2}, {"c", 3}};
+
+  std::string_view key = "c";
+
+  if (m.contains("b") && m.contains(key))
+  {
+    // We know "b" and "c" are in m
+  }
+}
+
+// Check whether a string key is in a hash table without allocating
+// a temporary `std::string` for each lookup.
+//
+// When we [check the existence of a key](/patterns/check-existence-of-key.html)
+// with a string literal or a
+// [`std::string_view`](cpp/string/basic_string_view) in a container
+// whose keys are `std::string`s, the argument is normally converted
+// to a `std::string` first. For long keys, this conversion allocates
+// memory on every lookup. An ordered container can avoid this with a
+// [transparent comparator](cpp/utility/functional/less_void). In
+// C++20, an unordered container can avoid it too, if both its hash
+// function and its equality comparison are transparent.
+//
+// The `string_hash` function object on [10-18] hashes any string
+// that can be viewed as a `std::string_view`, including
+// `std::string`s and string literals. Declaring the member type
+// `is_transparent` on [12] tells the container that this hash
+// function accepts keys of other types. The hash of a
+// `std::string_view` is required to equal the hash of a
+// `std::string` with the same characters, so keys are found
+// regardless of how they were passed.
+//
+// On [22-23], we create a
+// [`std::unordered_map`](cpp/container/unordered_map) that uses
+// `string_hash` and [`std::equal_to<>`](cpp/utility/functional/equal_to_void),
+// which compares its arguments with `==` and is itself transparent.
+//
+// On [27], we use the C++20 member function
+// [`contains`](cpp/container/unordered_map/contains) to look up a
+// string literal and a `std::string_view`. Neither lookup creates a
+// `std::string`. `contains` returns `true` if the key is in the map,
+// which expresses the intent of the check more clearly than
+// `count`.
+//
+// **Note**: `std::unordered_map` allocates a separate node for each
+// element, so every lookup follows at least one pointer. Hash tables
+// that store elements directly in their array of buckets, using
+// [open addressing](https://en.wikipedia.org/wiki/Open_addressing),
+// are often faster for lookup-heavy workloads. They are not part of
+// the standard library, but several libraries provide them with
+// the same interface, including transparent lookup.
@@ -0,0 +1,126 @@
+// Remove elements from a large container in parallel
+// C++11
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+template <typename T, typename Predicate>
+void parallel_erase_if(std::vector<T>& v, Predicate pred,
+                       unsigned tasks)
+{
+  tasks = std::max(1u, tasks);
+
+  std::size_t chunk = (v.size() + tasks - 1) / tasks;
+  std::vector<std::size_t> bounds(tasks + 1);
+  std::vector<std::size_t> offsets(tasks + 1);
+
+  for (unsigned i = 0; i <= tasks; ++i)
+    bounds[i] = std::min(i * chunk, v.size());
+
+  std::vector<std::future<void>> futures;
+  for (unsigned i = 0; i < tasks; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&, i] {
+      offsets[i + 1] = std::count_if(
+        std::begin(v) + bounds[i], std::begin(v) + bounds[i + 1],
+        [&](const T& x) { return !pred(x); });
+    }));
+  }
+  for (std::future<void>& f : futures) f.get();
+
+  std::partial_sum(std::begin(offsets), std::end(offsets),
+                   std::begin(offsets));
+
+  std::vector<T> result(offsets[tasks]);
+
+  futures.clear();
+  for (unsigned i = 0; i < tasks; ++i)
+  {
+    futures.push_back(std::async(std::launch::async, [&, i] {
+      std::copy_if(
+        std::make_move_iterator(std::begin(v) + bounds[i]),
+        std::make_move_iterator(std::begin(v) + bounds[i + 1]),
+        std::begin(result) + offsets[i],
+        [&](const T& x) { return !pred(x); });
+    }));
+  }
+  for (std::future<void>& f : futures) f.get();
+
+  v.swap(result);
+}
+
+int main()
+{
+  std::vector<int> v(10000000, 1);
+  unsigned tasks = std::max(1u, std::thread::hardware_concurrency());
+
+  parallel_erase_if(v, [](int i) { return i%2 == 0; }, tasks);
+}
+
+// Remove the elements of a very large container that match a
+// predicate using multiple threads, keeping the remaining elements
+// in their original order.
+//
+// The [erase-remove idiom](/patterns/remove-elements-from-container.html)
+// must process elements one after another, because the position to
+// which each kept element moves depends on how many elements were
+// kept before it. The `parallel_erase_if` function template on
+// [12-55] breaks this dependency in three steps, running `tasks`
+// tasks at the same time.
+//
+// If `tasks` is zero, as `std::thread::hardware_concurrency` may
+// return, we use a single task instead on [16].
+//
+// First, on [18-23], we divide the vector into `tasks` chunks of
+// roughly equal size and store the index at which each chunk begins
+// in `bounds`. On [25-34], we use [`std::async`](cpp/thread/async) to
+// count, in parallel, how many elements of each chunk will be kept,
+// using [`std::count_if`](cpp/algorithm/count) with the negated
+// predicate. Each task writes its count to its own element of
+// `offsets`, so no synchronization is needed. Calling `get` on each
+// [`std::future`](cpp/thread/future) on [34] waits for all of the
+// counts.
+//
+// Second, on [36-37], we compute a prefix sum of the counts with
+// [`std::partial_sum`](cpp/algorithm/partial_sum). Since the count
+// for chunk `i` was stored at index `i + 1`, `offsets[i]` is now the
+// number of elements kept from all of the chunks before chunk `i`,
+// which is exactly where chunk `i`'s kept elements belong in the
+// result. The final element, `offsets[tasks]`, is the total number
+// of elements kept, which we use to size `result` on [39].
+//
+// Third, on [41-52], each task copies the kept elements of its chunk
+// to its own part of `result` with
+// [`std::copy_if`](cpp/algorithm/copy). The parts do not overlap, so
+// again the tasks do not need to synchronize. We wrap the chunk's
+// iterators with
+// [`std::make_move_iterator`](cpp/iterator/make_move_iterator) on
+// [46-47], so that each kept element is moved rather than copied,
+// which matters for elements such as `std::string`s. The predicate
+// still only receives a `const` reference to each element. Finally,
+// on [54], we swap `result` into `v`.
+//
+// The predicate is called from several threads at once, so it must
+// be safe to do so. The lambda on [62] that removes even numbers
+// simply reads its argument and is therefore safe. Since every
+// element is read twice and the kept elements are moved into a new
+// vector, this is only worthwhile for very large containers, and
+// the speedup depends on the available memory bandwidth. While
+// `result` is being filled, both vectors exist at the same time, so
+// the peak memory use is up to twice the size of `v`.
+//
+// Creating `result` with its final size on [39] default-constructs
+// each of its elements before they are overwritten, so `T` must be
+// default constructible. A `std::vector` cannot be given a size
+// without constructing its elements, so avoiding this would require
+// managing uninitialized storage by hand.
+//
+// **Note**: In C++17, we can instead pass the
+// [`std::execution::par`](cpp/algorithm/execution_policy_tag)
+// execution policy to [`std::remove_if`](cpp/algorithm/remove),
+// which also keeps the remaining elements in order.
@@ -0,0 +1,69 @@
+// Remove elements from a container without branching
+// C++11
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+template <typename T, typename Predicate>
+void erase_if_branchless(std::vector<T>& v, Predicate pred)
+{
+  static_assert(std::is_trivially_copyable<T>::value,
+                "T must be trivially copyable");
+
+  std::size_t kept = 0;
+
+  for (std::size_t i = 0; i < v.size(); ++i)
+  {
+    T value = v[i];
+    v[kept] = value;
+    kept += !pred(value);
+  }
+
+  v.resize(kept);
+}
+
+int main()
+{
+  std::vector<int> v = {1, 2, 3, 4, 2, 5, 2, 6};
+
+  erase_if_branchless(v, [](int i) { return i%2 == 0; });
+}
+
+// Remove elements matching a predicate from a container of simple
+// values without a hard-to-predict branch for each element.
+//
+// The [erase-remove idiom](/patterns/remove-elements-from-container.html)
+// with [`std::remove_if`](cpp/algorithm/remove) typically tests the
+// predicate with an `if` statement and only moves an element when it
+// is kept. When the kept and removed elements are mixed unpredictably,
+// the processor often guesses the outcome of that branch wrongly,
+// and each wrong guess costs many cycles.
+//
+// The `erase_if_branchless` function template on [8-24] removes
+// every element for which `pred` returns `true`, keeping the
+// remaining elements in their original order. It uses `kept` on [14]
+// both as the number of elements kept so far and as the position at
+// which to write the next one.
+//
+// On [16-21], we visit each element in turn. Rather than testing the
+// predicate to decide whether to write the element, we always write
+// it to position `kept` on [19]. We then add the negated result of the
+// predicate to `kept` on [20], which advances the write position only
+// if the element should be kept. A removed element is simply
+// overwritten by the next element that we write. Because `kept` never
+// exceeds `i`, we never overwrite an element before we have read it.
+// The loop body contains no conditional branch, so its speed does not
+// depend on which elements are removed.
+//
+// After the loop, the first `kept` elements are the elements that we
+// wish to keep, so on [23] we [`resize`](cpp/container/vector/resize)
+// the vector to remove the rest.
+//
+// Writing every element, including those that are removed, is only
+// cheap for small values that can be copied with a few instructions,
+// so we use `static_assert` on [11-12] to restrict `T` to
+// [trivially copyable](cpp/types/is_trivially_copyable) types. For
+// simple predicates, such as the one in `main` on [30] that
+// removes even numbers, compilers may also be able to vectorize this
+// loop.
@@ -0,0 +1,127 @@
+// Store small sequences without heap allocation
+// C++11
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+template <typename T, std::size_t N>
+class small_vector
+{
+  public:
+    small_vector() = default;
+
+    small_vector(std::initializer_list<T> values)
+    {
+      for (const T& value : values)
+        push_back(value);
+    }
+
+    void push_back(const T& value)
+    {
+      if (heap_elements.empty() && count < N) {
+        inline_elements[count] = value;
+        ++count;
+      } else {
+        if (heap_elements.empty()) {
+          heap_elements.assign(std::begin(inline_elements),
+                               std::end(inline_elements));
+          count = 0;
+        }
+        heap_elements.push_back(value);
+      }
+    }
+
+    std::size_t size() const
+    {
+      return heap_elements.empty() ? count : heap_elements.size();
+    }
+
+    T* begin()
+    {
+      return heap_elements.empty() ? inline_elements.data()
+                                   : heap_elements.data();
+    }
+
+    const T* begin() const
+    {
+      return heap_elements.empty() ? inline_elements.data()
+                                   : heap_elements.data();
+    }
+
+    T* end() { return begin() + size(); }
+    const T* end() const { return begin() + size(); }
+
+    T& operator[](std::size_t i) { return begin()[i]; }
+    const T& operator[](std::size_t i) const { return begin()[i]; }
+
+  private:
+    std::array<T, N> inline_elements{};
+    std::vector<T> heap_elements;
+    std::size_t count = 0;
+};
+
+class foo
+{
+  private:
+    int x = 10;
+    small_vector<int, 8> v = {1, 2, 3, 4, 5};
+};
+
+// Store a sequence of elements that is usually short inside the
+// object itself, only allocating on the heap when it grows large.
+//
+// The class `foo` in the [rule of zero](/patterns/rule-of-zero.html)
+// holds a [`std::vector`](cpp/container/vector) of five elements.
+// A `std::vector` always stores its elements on the heap, so every
+// construction or copy of `foo` performs a heap allocation, even
+// though the sequence is short.
+//
+// The `small_vector` class template on [9-63] stores up to `N`
+// elements in a [`std::array`](cpp/container/array), declared on
+// [60], which lives inside the `small_vector` itself. Only when more
+// than `N` elements are added does it use the `std::vector` on [61].
+// While the vector is empty, `count` on [62] holds the number of
+// elements in the array. Once the elements have moved to the vector,
+// the vector itself keeps track of how many there are.
+//
+// The `push_back` member function on [21-34] stores a new element in
+// the array while there is room on [23-25]. When the array is full,
+// we first copy its `N` elements into the vector and reset `count` on
+// [27-31], and then add this and any later elements to the vector on
+// [32]. The `size` and `begin` member functions on [36-51] check
+// whether the vector is empty to decide which of the two holds the
+// elements. `end` and `operator[]`, on [53-57], are implemented in
+// terms of `begin` and `size`. Each of them also has a `const`
+// overload, so that a `const small_vector` can be read and iterated.
+//
+// Every member of `small_vector` is a type that already has the
+// correct copy and move semantics, so `small_vector` does not declare
+// any copy or move operations, following the rule of zero. Copying a
+// short `small_vector` copies its array and an empty `std::vector`,
+// which does not allocate. Moving a long one moves the `std::vector`,
+// which transfers its storage without copying the elements. Moving a
+// short one copies at most `N` elements, which is cheap when `N` is
+// small. Because the size is always taken from whichever member owns
+// the elements, a `small_vector` that has been moved from is still
+// valid and can be used again, just like a moved-from `std::vector`.
+//
+// The class `foo` on [65-70] now uses a `small_vector` with room for
+// eight `int`s on [69]. `foo` still follows the rule of zero, but
+// constructing or copying it no longer allocates.
+//
+// **Note**: For simplicity, this `small_vector` default-constructs all
+// `N` elements of its array up front, so `T` must be default
+// constructible and cheap to assign to. A full implementation, such
+// as those found in some libraries, constructs elements only when
+// they are added.
+
+#include <utility>
+
+int main()
+{
+  foo f1;
+  foo f2 = f1;
+  foo f3 = std::move(f1);
+}
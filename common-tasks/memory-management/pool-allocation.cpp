@@ -0,0 +1,211 @@
+// Allocate small objects from a pool
+// C++17
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+template <typename T>
+class pool
+{
+  public:
+    static void* allocate()
+    {
+      free_list& local = thread_list;
+      if (!local.head)
+        refill(local);
+
+      return pop(local);
+    }
+
+    static void deallocate(void* p) noexcept
+    {
+      free_list& local = thread_list;
+      push(local, static_cast<node*>(p));
+
+      if (local.count >= 2 * batch_size)
+        release(local, batch_size);
+    }
+
+  private:
+    union node
+    {
+      node* next;
+      alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    struct free_list
+    {
+      node* head = nullptr;
+      std::size_t count = 0;
+    };
+
+    struct thread_free_list : free_list
+    {
+      ~thread_free_list() { release(*this, this->count); }
+    };
+
+    static void push(free_list& list, node* n) noexcept
+    {
+      n->next = list.head;
+      list.head = n;
+      ++list.count;
+    }
+
+    static node* pop(free_list& list) noexcept
+    {
+      node* n = list.head;
+      list.head = n->next;
+      --list.count;
+      return n;
+    }
+
+    static void refill(free_list& local)
+    {
+      std::lock_guard<std::mutex> lock{global_mutex};
+
+      if (!global_list.head) {
+        chunks.push_back(std::make_unique<node[]>(chunk_size));
+
+        for (std::size_t i = 0; i < chunk_size; ++i)
+          push(global_list, &chunks.back()[i]);
+      }
+
+      while (global_list.head && local.count < batch_size)
+        push(local, pop(global_list));
+    }
+
+    static void release(free_list& local, std::size_t n) noexcept
+    {
+      std::lock_guard<std::mutex> lock{global_mutex};
+
+      for (; n > 0; --n)
+        push(global_list, pop(local));
+    }
+
+    static constexpr std::size_t batch_size = 64;
+    static constexpr std::size_t chunk_size = 1024;
+
+    inline static thread_local thread_free_list thread_list;
+    inline static std::mutex global_mutex;
+    inline static free_list global_list;
+    inline static std::vector<std::unique_ptr<node[]>> chunks;
+};
+
+class resource
+{
+  public:
+    static void* operator new(std::size_t size)
+    {
+      if (size != sizeof(resource))
+        return ::operator new(size);
+
+      return pool<resource>::allocate();
+    }
+
+    static void operator delete(void* p, std::size_t size) noexcept
+    {
+      if (size == sizeof(resource))
+        pool<resource>::deallocate(p);
+      else
+        ::operator delete(p);
+    }
+
+  private:
+    int x = 0;
+};
+
+class foo
+{
+  public:
+    foo()
+      : p{new resource{}}
+    { }
+
+    foo(const foo& other)
+      : p{new resource{*(other.p)}}
+    { }
+
+    // Move constructor and assignment operators...
+
+    ~foo()
+    {
+      delete p;
+    }
+
+  private:
+    resource* p;
+};
+
+// Reduce the cost of allocating and deallocating many small objects
+// of the same type.
+//
+// Classes that follow the [rule of five](/patterns/rule-of-five.html)
+// often allocate a small resource with `new` every time an object is
+// constructed or copied, and deallocate it with `delete` every time
+// an object is destroyed. A general-purpose allocator must handle
+// allocations of any size from any thread, so each of these calls
+// does more work than is needed for objects that all have the same
+// size.
+//
+// The `pool` class template on [9-94] hands out blocks of memory big
+// enough for one `T` each. Each block is a `node` ([32-36]): a union
+// that holds either a `T` object or, while the block is free, a
+// pointer to the next free block. The free blocks form linked lists,
+// called *free lists*, each of which is a `free_list` ([38-42])
+// holding the first block and the number of blocks in the list.
+// `push` and `pop` on [49-62] add and remove a block at the front.
+//
+// Each thread has its own free list, `thread_list` on [90], which is
+// declared [`thread_local`](cpp/language/storage_duration). `allocate`
+// ([13-20]) removes a block from the current thread's list and
+// `deallocate` ([22-29]) pushes a block back onto it. Both take only
+// a few instructions and need no synchronization.
+//
+// All threads also share a global free list, `global_list` on [92],
+// which is protected by `global_mutex` on [91]. When a thread's list
+// is empty, `allocate` calls `refill` ([64-77]), which moves up to
+// `batch_size` blocks from the global list to the thread's list on
+// [75-76]. Only if the global list is also empty do we allocate a new
+// chunk of blocks on [68-73], which is owned by `chunks` on [93].
+//
+// A block is not always freed by the thread that allocated it. For
+// example, one thread may create objects that another thread
+// destroys. The freeing thread's list then keeps growing, while the
+// allocating thread keeps running out of blocks. To prevent this,
+// when a thread's list holds twice `batch_size` blocks, `deallocate`
+// calls `release` ([79-85]) on [27-28] to return `batch_size` of them
+// to the global list, where the allocating thread can find them
+// again. When a thread exits, the destructor of its
+// `thread_free_list` ([44-47]) returns all of its remaining blocks in
+// the same way. Because blocks move in batches, threads only lock
+// `global_mutex` once every `batch_size` allocations or
+// deallocations at most. Chunks are only released when the program
+// exits, so the pool's memory grows to about the largest number of
+// objects alive at once, plus the blocks held by each thread.
+//
+// The `resource` class on [96-117] opts into the pool by declaring its
+// own [`operator new` and `operator
+// delete`](cpp/memory/new/operator_new) on [99-113]. Any `new` or
+// `delete` expression for a `resource` now uses the pool. The pool's
+// blocks are exactly the size of a `resource`, so a class derived
+// from `resource`, which inherits these functions, may be larger. We
+// check the `size` argument on [101] and [109] and fall back to the
+// global `operator new` and `operator delete` for any other size. The
+// class `foo` on [119-139], which manages a `resource`, is unchanged.
+// Its constructors and destructor still use `new` and `delete`, and
+// still have exactly the same semantics.
+//
+// **Note**: The static data members on [90-93] are
+// [inline variables](cpp/language/inline), which were introduced in
+// C++17. For C++11, they must instead be defined outside the class.
+// Objects allocated from the pool must not be destroyed by the
+// destructors of other static or `thread_local` objects, which may
+// run after the pool's own members have been destroyed.
+
+int main()
+{
+  foo f1;
+  foo f2 = f1;
+}